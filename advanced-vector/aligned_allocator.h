@@ -0,0 +1,56 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Аллокатор, выравнивающий буфер по границе Alignment байт (не меньше alignof(T)),
+// например по строке кэша или под загрузки AVX-512
+template <typename T, size_t Alignment = CACHE_LINE_SIZE>
+class AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr size_t ALIGNMENT = Alignment > alignof(T) ? Alignment : alignof(T);
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t{ALIGNMENT}));
+    }
+
+    void deallocate(T* p, size_t /*n*/) noexcept {
+        operator delete(p, std::align_val_t{ALIGNMENT});
+    }
+
+    bool operator==(const AlignedAllocator&) const noexcept {
+        return true;
+    }
+
+    bool operator!=(const AlignedAllocator&) const noexcept {
+        return false;
+    }
+};
+
+// Вектор, данные которого начинаются на границе Alignment байт
+template <typename T, size_t Alignment = CACHE_LINE_SIZE>
+using AlignedVector = Vector<T, AlignedAllocator<T, Alignment>>;
@@ -0,0 +1,687 @@
+#include "vector.h"
+#include "aligned_allocator.h"
+#include "bit_vector.h"
+#include "parallel_sort.h"
+#include "pool_allocator.h"
+#include "vector_simd.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <numeric>
+#include <string>
+#include <vector>
+
+// Сравнение Vector с std::vector.
+// Сборка: g++ -std=c++17 -O2 -DNDEBUG benchmark.cpp -lbenchmark -lpthread
+// Счётчики: allocs — выделений памяти за операцию, bytes_moved — байт, перенесённых
+// при реаллокациях, сдвигах и копировании, за операцию
+
+namespace {
+
+size_t num_allocations = 0;
+
+}  // namespace
+
+void* operator new(size_t size) {
+    ++num_allocations;
+    if (void* ptr = std::malloc(size != 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+// GCC принимает замену operator new/delete на malloc/free за несогласованную пару
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+struct Pod64 {
+    char data[64];
+};
+
+// Тип с неnoexcept перемещением: при реаллокации Vector копирует такие элементы
+struct ThrowingMove {
+    explicit ThrowingMove(int v = 0)
+        : value(v)
+    {}
+    ThrowingMove(const ThrowingMove& other)
+        : value(other.value)
+    {}
+    ThrowingMove(ThrowingMove&& other) noexcept(false)
+        : value(other.value)
+    {}
+    ThrowingMove& operator=(const ThrowingMove& other) {
+        value = other.value;
+        return *this;
+    }
+    ThrowingMove& operator=(ThrowingMove&& other) noexcept(false) {
+        value = other.value;
+        return *this;
+    }
+
+    int value;
+};
+
+template <typename T>
+T MakeValue(size_t i) {
+    if constexpr (std::is_same_v<T, int>) {
+        return static_cast<int>(i);
+    } else if constexpr (std::is_same_v<T, Pod64>) {
+        Pod64 pod{};
+        pod.data[0] = static_cast<char>(i);
+        return pod;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        // Длиннее буфера короткой строки, чтобы строка жила в куче
+        return std::string(32, static_cast<char>('a' + i % 26));
+    } else {
+        return T(static_cast<int>(i));
+    }
+}
+
+// Единый интерфейс к std::vector и Vector
+
+template <typename T>
+void PushBack(std::vector<T>& v, const T& value) {
+    v.push_back(value);
+}
+template <typename T>
+void PushBack(Vector<T>& v, const T& value) {
+    v.PushBack(value);
+}
+
+template <typename T>
+void EmplaceBack(std::vector<T>& v, T&& value) {
+    v.emplace_back(std::move(value));
+}
+template <typename T>
+void EmplaceBack(Vector<T>& v, T&& value) {
+    v.EmplaceBack(std::move(value));
+}
+
+template <typename T>
+void InsertAt(std::vector<T>& v, size_t index, const T& value) {
+    v.insert(v.begin() + index, value);
+}
+template <typename T>
+void InsertAt(Vector<T>& v, size_t index, const T& value) {
+    v.Insert(v.cbegin() + index, value);
+}
+
+template <typename T>
+void EraseAt(std::vector<T>& v, size_t index) {
+    v.erase(v.begin() + index);
+}
+template <typename T>
+void EraseAt(Vector<T>& v, size_t index) {
+    v.Erase(v.cbegin() + index);
+}
+
+template <typename T>
+void Reserve(std::vector<T>& v, size_t n) {
+    v.reserve(n);
+}
+template <typename T>
+void Reserve(Vector<T>& v, size_t n) {
+    v.Reserve(n);
+}
+
+template <typename T>
+void Resize(std::vector<T>& v, size_t n) {
+    v.resize(n);
+}
+template <typename T>
+void Resize(Vector<T>& v, size_t n) {
+    v.Resize(n);
+}
+
+template <typename T>
+size_t Capacity(const std::vector<T>& v) {
+    return v.capacity();
+}
+template <typename T>
+size_t Capacity(const Vector<T>& v) {
+    return v.Capacity();
+}
+
+template <typename Container>
+using ValueType = std::decay_t<decltype(*std::declval<Container&>().begin())>;
+
+template <typename Container>
+Container MakeContainer(size_t n) {
+    using T = ValueType<Container>;
+    Container v;
+    Reserve(v, n);
+    for (size_t i = 0; i < n; ++i) {
+        PushBack(v, MakeValue<T>(i));
+    }
+    return v;
+}
+
+void SetCounters(benchmark::State& state, size_t allocations, size_t bytes_moved, size_t ops_per_iteration) {
+    const double ops = static_cast<double>(state.iterations()) * static_cast<double>(ops_per_iteration);
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations) / ops);
+    state.counters["bytes_moved"] = benchmark::Counter(static_cast<double>(bytes_moved) / ops);
+    state.SetItemsProcessed(static_cast<int64_t>(ops));
+}
+
+template <typename Container>
+void BM_PushBack(benchmark::State& state) {
+    using T = ValueType<Container>;
+    const auto n = static_cast<size_t>(state.range(0));
+    const T value = MakeValue<T>(n);
+    size_t allocations = 0;
+    size_t bytes_moved = 0;
+    for (auto _ : state) {
+        const size_t old_allocations = num_allocations;
+        Container v;
+        for (size_t i = 0; i < n; ++i) {
+            const size_t capacity = Capacity(v);
+            PushBack(v, value);
+            if (Capacity(v) != capacity) {
+                bytes_moved += i * sizeof(T);
+            }
+        }
+        benchmark::DoNotOptimize(v.begin());
+        allocations += num_allocations - old_allocations;
+    }
+    SetCounters(state, allocations, bytes_moved, n);
+}
+
+template <typename Container>
+void BM_EmplaceBack(benchmark::State& state) {
+    using T = ValueType<Container>;
+    const auto n = static_cast<size_t>(state.range(0));
+    size_t allocations = 0;
+    size_t bytes_moved = 0;
+    for (auto _ : state) {
+        const size_t old_allocations = num_allocations;
+        Container v;
+        for (size_t i = 0; i < n; ++i) {
+            const size_t capacity = Capacity(v);
+            EmplaceBack(v, MakeValue<T>(i));
+            if (Capacity(v) != capacity) {
+                bytes_moved += i * sizeof(T);
+            }
+        }
+        benchmark::DoNotOptimize(v.begin());
+        allocations += num_allocations - old_allocations;
+    }
+    SetCounters(state, allocations, bytes_moved, n);
+}
+
+// Вставка и удаление в середине вектора: каждая операция сдвигает половину элементов
+template <typename Container>
+void BM_InsertEraseMiddle(benchmark::State& state) {
+    using T = ValueType<Container>;
+    const auto n = static_cast<size_t>(state.range(0));
+    Container v = MakeContainer<Container>(n);
+    Reserve(v, n + 1);
+    const T value = MakeValue<T>(n);
+    size_t allocations = 0;
+    size_t bytes_moved = 0;
+    for (auto _ : state) {
+        const size_t old_allocations = num_allocations;
+        InsertAt(v, n / 2, value);
+        EraseAt(v, n / 2);
+        benchmark::ClobberMemory();
+        allocations += num_allocations - old_allocations;
+        bytes_moved += 2 * (n - n / 2) * sizeof(T);
+    }
+    SetCounters(state, allocations, bytes_moved, 2);
+}
+
+template <typename Container>
+void BM_Reserve(benchmark::State& state) {
+    using T = ValueType<Container>;
+    const auto n = static_cast<size_t>(state.range(0));
+    size_t allocations = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container v = MakeContainer<Container>(n);
+        const size_t old_allocations = num_allocations;
+        state.ResumeTiming();
+
+        Reserve(v, n * 2);
+        benchmark::DoNotOptimize(v.begin());
+
+        state.PauseTiming();
+        allocations += num_allocations - old_allocations;
+        v = Container();
+        state.ResumeTiming();
+    }
+    SetCounters(state, allocations, n * sizeof(T) * state.iterations(), 1);
+}
+
+template <typename Container>
+void BM_CopyAssign(benchmark::State& state) {
+    using T = ValueType<Container>;
+    const auto n = static_cast<size_t>(state.range(0));
+    const Container source = MakeContainer<Container>(n);
+    Container v;
+    size_t allocations = 0;
+    for (auto _ : state) {
+        const size_t old_allocations = num_allocations;
+        v = source;
+        benchmark::DoNotOptimize(v.begin());
+        allocations += num_allocations - old_allocations;
+    }
+    SetCounters(state, allocations, n * sizeof(T) * state.iterations(), 1);
+}
+
+template <typename Container>
+void BM_MoveAssign(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    Container v;
+    size_t allocations = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container source = MakeContainer<Container>(n);
+        const size_t old_allocations = num_allocations;
+        state.ResumeTiming();
+
+        v = std::move(source);
+        benchmark::DoNotOptimize(v.begin());
+
+        state.PauseTiming();
+        allocations += num_allocations - old_allocations;
+        state.ResumeTiming();
+    }
+    SetCounters(state, allocations, 0, 1);
+}
+
+template <typename Container>
+void BM_Resize(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    size_t allocations = 0;
+    for (auto _ : state) {
+        const size_t old_allocations = num_allocations;
+        Container v;
+        Resize(v, n);
+        benchmark::DoNotOptimize(v.begin());
+        allocations += num_allocations - old_allocations;
+    }
+    SetCounters(state, allocations, 0, 1);
+}
+
+// Политики роста: число выделений и сколько из них поместилось бы в ранее освобождённую память
+
+struct GrowthStats {
+    size_t allocations = 0;
+    size_t freed_bytes = 0;
+    size_t reusable_allocations = 0;
+};
+
+template <typename T>
+struct GrowthStatsAllocator {
+    using value_type = T;
+
+    GrowthStatsAllocator() = default;
+
+    template <typename U>
+    GrowthStatsAllocator(const GrowthStatsAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        ++stats.allocations;
+        if (stats.freed_bytes >= n * sizeof(T)) {
+            ++stats.reusable_allocations;
+        }
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        stats.freed_bytes += n * sizeof(T);
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    bool operator==(const GrowthStatsAllocator&) const noexcept {
+        return true;
+    }
+    bool operator!=(const GrowthStatsAllocator&) const noexcept {
+        return false;
+    }
+
+    static inline GrowthStats stats;
+};
+
+template <typename Growth>
+void BM_GrowthPolicy(benchmark::State& state) {
+    using Alloc = GrowthStatsAllocator<int>;
+    const auto n = static_cast<size_t>(state.range(0));
+    size_t capacity = 0;
+    Alloc::stats = {};
+    for (auto _ : state) {
+        Alloc::stats.freed_bytes = 0;
+        Vector<int, Alloc, Growth> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        capacity = v.Capacity();
+        benchmark::DoNotOptimize(v.begin());
+    }
+    const auto iterations = static_cast<double>(state.iterations());
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(Alloc::stats.allocations) / iterations);
+    state.counters["reused"] = benchmark::Counter(static_cast<double>(Alloc::stats.reusable_allocations) / iterations);
+    state.counters["capacity"] = benchmark::Counter(static_cast<double>(capacity));
+}
+
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, DoublingGrowth)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, GeometricGrowth<2, 1>)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, GeometricGrowth<3, 2>)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, SizeClassGrowth<>)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+
+// Много маленьких внутренних векторов: стоимость определяется выделениями при их росте
+template <template <typename> typename Alloc>
+void BM_NestedSmallVectors(benchmark::State& state) {
+    using Inner = Vector<int, Alloc<int>>;
+    const auto n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Vector<Inner, Alloc<Inner>> v(n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < i % 16; ++j) {
+                v[i].PushBack(static_cast<int>(j));
+            }
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_NestedSmallVectors, std::allocator)->Arg(100'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_NestedSmallVectors, PoolAllocator)->Arg(100'000)->Unit(benchmark::kMicrosecond);
+
+// Добавление n целых в зарезервированный вектор: EmplaceBack, AppendSession
+// и запись через сырой указатель как нижняя граница
+enum class AppendMode {
+    EMPLACE_BACK,
+    SESSION,
+    RAW_POINTER,
+};
+
+template <AppendMode Mode>
+void BM_Append(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    Vector<int> v;
+    v.Reserve(n);
+    for (auto _ : state) {
+        v.Clear();
+        if constexpr (Mode == AppendMode::EMPLACE_BACK) {
+            for (size_t i = 0; i < n; ++i) {
+                v.EmplaceBack(static_cast<int>(i));
+            }
+        } else if constexpr (Mode == AppendMode::SESSION) {
+            auto session = v.BeginAppend(n);
+            for (size_t i = 0; i < n; ++i) {
+                session.Emplace(static_cast<int>(i));
+            }
+        } else {
+            int* out = v.AppendUninitialized(n);
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = static_cast<int>(i);
+            }
+        }
+        benchmark::DoNotOptimize(v.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+BENCHMARK_TEMPLATE(BM_Append, AppendMode::EMPLACE_BACK)->Arg(100'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Append, AppendMode::SESSION)->Arg(100'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Append, AppendMode::RAW_POINTER)->Arg(100'000)->Unit(benchmark::kMicrosecond);
+
+// std::sort против ParallelSort с переиспользуемым буфером; перестановка входных данных
+// входит в замер обоих вариантов
+template <bool Parallel>
+void BM_Sort(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    Vector<int> v(n);
+    RawMemory<int> scratch;
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            v[i] = static_cast<int>((i * 2654435761u) % n);
+        }
+        if constexpr (Parallel) {
+            ParallelSort(v, std::less<>{}, scratch);
+        } else {
+            std::sort(v.begin(), v.end());
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Sort, false)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Sort, true)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+// Подсчёт битов 8 * 10^6 флагов: Vector<bool> с байтом на флаг против BitVector
+// со скалярным ядром и с лучшим доступным набором инструкций
+void BM_CountFlags(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    Vector<bool> bytes(n);
+    for (size_t i = 0; i < n; i += 3) {
+        bytes[i] = true;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(bytes.begin(), bytes.end(), true));
+    }
+}
+
+template <SimdLevel Level>
+void BM_BitVectorCount(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    BitVector<> bits(n);
+    for (size_t i = 0; i < n; i += 3) {
+        bits[i] = true;
+    }
+    const SimdLevel original = GetSimdLevel();
+    SetSimdLevel(Level);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bits.Count());
+    }
+    SetSimdLevel(original);
+}
+
+BENCHMARK(BM_CountFlags)->Arg(8'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BitVectorCount, SimdLevel::SCALAR)->Arg(8'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BitVectorCount, SimdLevel::AVX512)->Arg(8'000'000)->Unit(benchmark::kMicrosecond);
+
+// Размеры от 8 до 10^8 элементов, но не больше ~1 ГБ данных на вектор
+template <typename T>
+int64_t MaxSize(int64_t limit) {
+    const int64_t footprint = static_cast<int64_t>(sizeof(T)) * (std::is_same_v<T, std::string> ? 2 : 1);
+    return std::max<int64_t>(8, std::min<int64_t>(limit, (int64_t{1} << 30) / footprint));
+}
+
+void ApplySizes(benchmark::internal::Benchmark* bench, int64_t max_size) {
+    bench->Arg(8);
+    for (int64_t size = 100; size <= max_size; size *= 10) {
+        bench->Arg(size);
+    }
+}
+
+template <typename T>
+void RegisterForType(const std::string& type_name) {
+    const int64_t max_size = MaxSize<T>(100'000'000);
+    // Операции в середине стоят O(n) каждая, для них хватает размеров до 10^6
+    const int64_t max_middle_size = MaxSize<T>(1'000'000);
+
+    auto add = [&](const std::string& name, auto bench_std, auto bench_vector, int64_t sizes) {
+        ApplySizes(benchmark::RegisterBenchmark((name + "/std::vector<" + type_name + ">").c_str(), bench_std)
+                       ->Unit(benchmark::kMicrosecond),
+                   sizes);
+        ApplySizes(benchmark::RegisterBenchmark((name + "/Vector<" + type_name + ">").c_str(), bench_vector)
+                       ->Unit(benchmark::kMicrosecond),
+                   sizes);
+    };
+
+    add("PushBack", BM_PushBack<std::vector<T>>, BM_PushBack<Vector<T>>, max_size);
+    add("EmplaceBack", BM_EmplaceBack<std::vector<T>>, BM_EmplaceBack<Vector<T>>, max_size);
+    add("InsertEraseMiddle", BM_InsertEraseMiddle<std::vector<T>>, BM_InsertEraseMiddle<Vector<T>>,
+        max_middle_size);
+    add("Reserve", BM_Reserve<std::vector<T>>, BM_Reserve<Vector<T>>, max_size);
+    add("CopyAssign", BM_CopyAssign<std::vector<T>>, BM_CopyAssign<Vector<T>>, max_size);
+    add("MoveAssign", BM_MoveAssign<std::vector<T>>, BM_MoveAssign<Vector<T>>, max_size);
+    add("Resize", BM_Resize<std::vector<T>>, BM_Resize<Vector<T>>, max_size);
+}
+
+// Ядра vector_simd.h против скалярных алгоритмов std на выровненном буфере
+template <typename T>
+AlignedVector<T> MakeKernelInput(size_t n) {
+    AlignedVector<T> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = static_cast<T>(i % 1000);
+    }
+    return v;
+}
+
+struct FillStd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec&) {
+        std::fill(v.begin(), v.end(), 1);
+        return v.begin();
+    }
+};
+
+struct FillSimd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec&) {
+        Fill(v, 1);
+        return v.begin();
+    }
+};
+
+struct SumStd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec&) {
+        return std::accumulate(v.begin(), v.end(), std::decay_t<decltype(v[0])>{});
+    }
+};
+
+struct SumSimd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec&) {
+        return Sum(v);
+    }
+};
+
+struct MinMaxStd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec&) {
+        return std::minmax_element(v.begin(), v.end());
+    }
+};
+
+struct MinMaxSimd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec&) {
+        return MinMax(v);
+    }
+};
+
+// Искомого значения нет, поиск проходит весь вектор
+struct FindStd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec&) {
+        return std::find(v.begin(), v.end(), 5000);
+    }
+};
+
+struct FindSimd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec&) {
+        return Find(v, 5000);
+    }
+};
+
+struct CountStd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec&) {
+        return std::count(v.begin(), v.end(), 7);
+    }
+};
+
+struct CountSimd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec&) {
+        return Count(v, 7);
+    }
+};
+
+struct TransformStd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec& out) {
+        std::transform(v.begin(), v.end(), v.begin(), out.begin(), std::plus<>{});
+        return out.begin();
+    }
+};
+
+struct TransformSimd {
+    template <typename Vec>
+    static auto Run(Vec& v, Vec& out) {
+        Transform(v, v, out, std::plus<>{});
+        return out.begin();
+    }
+};
+
+template <typename T, typename Kernel>
+void BM_Kernel(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    AlignedVector<T> v = MakeKernelInput<T>(n);
+    AlignedVector<T> out(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Kernel::Run(v, out));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n * sizeof(T)));
+}
+
+template <typename T>
+void RegisterKernelsForType(const std::string& type_name) {
+    auto add = [&](const std::string& name, const std::string& std_name, auto bench_std, auto bench_simd) {
+        for (const auto& [label, bench] : {std::pair{std_name, bench_std}, std::pair{name, bench_simd}}) {
+            benchmark::RegisterBenchmark(("Simd" + name + "/" + label + "<" + type_name + ">").c_str(), bench)
+                ->Arg(1'000)
+                ->Arg(100'000)
+                ->Arg(10'000'000)
+                ->Unit(benchmark::kMicrosecond);
+        }
+    };
+
+    add("Fill", "std::fill", BM_Kernel<T, FillStd>, BM_Kernel<T, FillSimd>);
+    add("Sum", "std::accumulate", BM_Kernel<T, SumStd>, BM_Kernel<T, SumSimd>);
+    add("MinMax", "std::minmax_element", BM_Kernel<T, MinMaxStd>, BM_Kernel<T, MinMaxSimd>);
+    add("Find", "std::find", BM_Kernel<T, FindStd>, BM_Kernel<T, FindSimd>);
+    add("Count", "std::count", BM_Kernel<T, CountStd>, BM_Kernel<T, CountSimd>);
+    add("Transform", "std::transform", BM_Kernel<T, TransformStd>, BM_Kernel<T, TransformSimd>);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    RegisterForType<int>("int");
+    RegisterForType<Pod64>("Pod64");
+    RegisterForType<std::string>("std::string");
+    RegisterForType<ThrowingMove>("ThrowingMove");
+    RegisterKernelsForType<int>("int");
+    RegisterKernelsForType<float>("float");
+    RegisterKernelsForType<double>("double");
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+}
@@ -0,0 +1,451 @@
+#pragma once
+
+#include "vector.h"
+#include "vector_simd.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#if defined(VECTOR_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+// Ядра над словами битового вектора. Выбор набора инструкций общий с vector_simd.h
+// (GetSimdLevel, SetSimdLevel): с AVX2 подсчёт идёт по таблице через vpshufb, поиск
+// и логические операции — по 256 бит, на x86 без AVX2 подсчёт использует popcnt,
+// если процессор его поддерживает
+namespace bit_detail {
+
+inline constexpr size_t WORD_BITS = 64;
+
+inline size_t WordCount(size_t bits) noexcept {
+    return (bits + WORD_BITS - 1) / WORD_BITS;
+}
+
+enum class BitOp {
+    AND,
+    OR,
+    XOR,
+};
+
+template <BitOp Op>
+inline uint64_t Apply(uint64_t lhs, uint64_t rhs) noexcept {
+    if constexpr (Op == BitOp::AND) {
+        return lhs & rhs;
+    } else if constexpr (Op == BitOp::OR) {
+        return lhs | rhs;
+    } else {
+        return lhs ^ rhs;
+    }
+}
+
+struct ScalarBits {
+    [[gnu::always_inline]] static size_t Count(const uint64_t* words, size_t count) noexcept {
+        size_t bits = 0;
+        for (size_t i = 0; i < count; ++i) {
+            bits += static_cast<size_t>(__builtin_popcountll(words[i]));
+        }
+        return bits;
+    }
+
+    // Индекс первого ненулевого слова из [first, count) или count
+    static size_t FindNonZero(const uint64_t* words, size_t first, size_t count) noexcept {
+        while (first < count && words[first] == 0) {
+            ++first;
+        }
+        return first;
+    }
+
+    template <BitOp Op>
+    static void Combine(uint64_t* lhs, const uint64_t* rhs, size_t count) noexcept {
+        for (size_t i = 0; i < count; ++i) {
+            lhs[i] = Apply<Op>(lhs[i], rhs[i]);
+        }
+    }
+};
+
+#if defined(VECTOR_SIMD_X86)
+
+// Тот же цикл, но popcnt — одна инструкция, а не программный подсчёт
+__attribute__((target("popcnt"))) inline size_t CountPopcnt(const uint64_t* words, size_t count) noexcept {
+    return ScalarBits::Count(words, count);
+}
+
+inline bool HasPopcnt() noexcept {
+    static const bool supported = __builtin_cpu_supports("popcnt");
+    return supported;
+}
+
+// Подсчёт по таблице тетрад (vpshufb) с суммированием байтов через vpsadbw
+__attribute__((target("avx2,popcnt"))) inline size_t CountAvx2(const uint64_t* words, size_t count) noexcept {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        const __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(x, low_mask));
+        const __m256i high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x, 4), low_mask));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + ScalarBits::Count(words + i, count - i);
+}
+
+__attribute__((target("avx2"))) inline size_t FindNonZeroAvx2(const uint64_t* words, size_t first,
+                                                             size_t count) noexcept {
+    for (; first + 4 <= count; first += 4) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + first));
+        if (!_mm256_testz_si256(x, x)) {
+            break;
+        }
+    }
+    return ScalarBits::FindNonZero(words, first, count);
+}
+
+template <BitOp Op>
+__attribute__((target("avx2"))) void CombineAvx2(uint64_t* lhs, const uint64_t* rhs, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+        const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+        __m256i result;
+        if constexpr (Op == BitOp::AND) {
+            result = _mm256_and_si256(x, y);
+        } else if constexpr (Op == BitOp::OR) {
+            result = _mm256_or_si256(x, y);
+        } else {
+            result = _mm256_xor_si256(x, y);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lhs + i), result);
+    }
+    ScalarBits::Combine<Op>(lhs + i, rhs + i, count - i);
+}
+
+#endif  // VECTOR_SIMD_X86
+
+inline size_t Count(const uint64_t* words, size_t count) noexcept {
+#if defined(VECTOR_SIMD_X86)
+    const SimdLevel level = GetSimdLevel();
+    if (level >= SimdLevel::AVX2) {
+        return CountAvx2(words, count);
+    }
+    if (level != SimdLevel::SCALAR && HasPopcnt()) {
+        return CountPopcnt(words, count);
+    }
+#endif
+    return ScalarBits::Count(words, count);
+}
+
+inline size_t FindNonZero(const uint64_t* words, size_t first, size_t count) noexcept {
+#if defined(VECTOR_SIMD_X86)
+    if (GetSimdLevel() >= SimdLevel::AVX2) {
+        return FindNonZeroAvx2(words, first, count);
+    }
+#endif
+    return ScalarBits::FindNonZero(words, first, count);
+}
+
+template <BitOp Op>
+void Combine(uint64_t* lhs, const uint64_t* rhs, size_t count) noexcept {
+#if defined(VECTOR_SIMD_X86)
+    if (GetSimdLevel() >= SimdLevel::AVX2) {
+        CombineAvx2<Op>(lhs, rhs, count);
+        return;
+    }
+#endif
+    ScalarBits::Combine<Op>(lhs, rhs, count);
+}
+
+}  // namespace bit_detail
+
+// Битовый вектор: бит на флаг в словах uint64_t поверх RawMemory, рост словами по политике
+// Growth, как у Vector. Это отдельный контейнер, а не специализация Vector<bool>:
+// operator[] возвращает прокси reference, итераторов по битам нет, а обход установленных
+// битов идёт через FindFirst/FindNext:
+//   for (size_t i = bits.FindFirst(); i < bits.Size(); i = bits.FindNext(i)) { ... }
+// Биты последнего слова за Size() всегда нулевые, поэтому Count и логические операции
+// работают целыми словами
+template <typename Alloc = std::allocator<uint64_t>, typename Growth = DoublingGrowth>
+class BitVector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    static constexpr size_t WORD_BITS = bit_detail::WORD_BITS;
+
+public:
+    // Ссылка на бит. Как у std::vector<bool>::reference, копия ссылается на тот же бит
+    class reference {
+    public:
+        reference(const reference&) = default;
+
+        operator bool() const noexcept {
+            return (*word_ & mask_) != 0;
+        }
+
+        reference& operator=(bool value) noexcept {
+            if (value) {
+                *word_ |= mask_;
+            } else {
+                *word_ &= ~mask_;
+            }
+            return *this;
+        }
+
+        reference& operator=(const reference& other) noexcept {
+            return *this = static_cast<bool>(other);
+        }
+
+        void Flip() noexcept {
+            *word_ ^= mask_;
+        }
+
+    private:
+        friend class BitVector;
+
+        reference(uint64_t* word, uint64_t mask) noexcept
+            : word_(word)
+            , mask_(mask)
+        {}
+
+        uint64_t* word_;
+        uint64_t mask_;
+    };
+
+    BitVector() = default;
+
+    explicit BitVector(const Alloc& alloc) noexcept
+        : words_(alloc)
+    {}
+
+    explicit BitVector(size_t size, bool value = false, const Alloc& alloc = Alloc())
+        : words_(bit_detail::WordCount(size), alloc)
+        , size_(size)
+    {
+        std::fill_n(Words(), WordCount(), value ? ~uint64_t{0} : 0);
+        ClearTail();
+    }
+
+    BitVector(const BitVector& other)
+        : BitVector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {}
+
+    BitVector(const BitVector& other, const Alloc& alloc)
+        : words_(other.WordCount(), alloc)
+        , size_(other.size_)
+    {
+        CopyWords(other.Words(), other.WordCount());
+    }
+
+    BitVector(BitVector&& other) noexcept
+        : words_(std::move(other.words_))
+        , size_(std::exchange(other.size_, 0))
+    {}
+
+    BitVector& operator=(const BitVector& rhs) {
+        if (this != &rhs) {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                if (GetAllocator() != rhs.GetAllocator()) {
+                    size_ = 0;
+                    words_.Reset(rhs.GetAllocator());
+                }
+            }
+            if (rhs.WordCount() > words_.Capacity()) {
+                BitVector rhs_copy(rhs, GetAllocator());
+                Swap(rhs_copy);
+            } else {
+                CopyWords(rhs.Words(), rhs.WordCount());
+                size_ = rhs.size_;
+            }
+        }
+        return *this;
+    }
+
+    BitVector& operator=(BitVector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                                   || AllocTraits::is_always_equal::value) {
+        if (this != &rhs) {
+            if constexpr (!AllocTraits::propagate_on_container_move_assignment::value
+                          && !AllocTraits::is_always_equal::value) {
+                if (GetAllocator() != rhs.GetAllocator()) {
+                    *this = static_cast<const BitVector&>(rhs);
+                    rhs.size_ = 0;
+                    return *this;
+                }
+            }
+            words_ = std::move(rhs.words_);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return size_;
+    }
+
+    // Ёмкость в битах
+    [[nodiscard]] size_t Capacity() const noexcept {
+        return words_.Capacity() * WORD_BITS;
+    }
+
+    [[nodiscard]] Alloc GetAllocator() const noexcept {
+        return words_.GetAllocator();
+    }
+
+    // Слова с битами [64 * i, 64 * i + 64), младший бит слова — меньший индекс
+    [[nodiscard]] const uint64_t* Words() const noexcept {
+        return words_.GetAddress();
+    }
+
+    [[nodiscard]] size_t WordCount() const noexcept {
+        return bit_detail::WordCount(size_);
+    }
+
+    bool operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return (words_[index / WORD_BITS] >> (index % WORD_BITS) & 1) != 0;
+    }
+
+    reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return reference(&words_[index / WORD_BITS], uint64_t{1} << (index % WORD_BITS));
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > Capacity()) {
+            ChangeWordCapacity(bit_detail::WordCount(new_capacity));
+        }
+    }
+
+    // Новые биты получают значение value
+    void Resize(size_t new_size, bool value = false) {
+        if (new_size > size_) {
+            Reserve(new_size);
+            const size_t old_words = WordCount();
+            if (value && size_ % WORD_BITS != 0) {
+                words_[size_ / WORD_BITS] |= ~uint64_t{0} << (size_ % WORD_BITS);
+            }
+            std::fill(Words() + old_words, Words() + bit_detail::WordCount(new_size), value ? ~uint64_t{0} : 0);
+        }
+        size_ = new_size;
+        ClearTail();
+    }
+
+    void Clear() noexcept {
+        size_ = 0;
+    }
+
+    void PushBack(bool value) {
+        if (size_ == Capacity()) {
+            const size_t words = words_.Capacity();
+            ChangeWordCapacity(std::max(Growth::NextCapacity(words, sizeof(uint64_t)), words + 1));
+        }
+        const size_t index = size_++;
+        if (index % WORD_BITS == 0) {
+            words_[index / WORD_BITS] = 0;
+        }
+        if (value) {
+            words_[index / WORD_BITS] |= uint64_t{1} << (index % WORD_BITS);
+        }
+    }
+
+    void PopBack() noexcept {
+        assert(size_ > 0);
+        --size_;
+        ClearTail();
+    }
+
+    void Swap(BitVector& other) noexcept {
+        words_.Swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+
+    // Число установленных битов
+    [[nodiscard]] size_t Count() const noexcept {
+        return bit_detail::Count(Words(), WordCount());
+    }
+
+    // Индекс первого установленного бита или Size(), если таких нет
+    [[nodiscard]] size_t FindFirst() const noexcept {
+        return size_ != 0 ? FindFrom(0) : 0;
+    }
+
+    // Индекс первого установленного бита после pos или Size()
+    [[nodiscard]] size_t FindNext(size_t pos) const noexcept {
+        return pos + 1 < size_ ? FindFrom(pos + 1) : size_;
+    }
+
+    // Побитовые операции с вектором того же размера
+    BitVector& And(const BitVector& other) noexcept {
+        return Combine<bit_detail::BitOp::AND>(other);
+    }
+
+    BitVector& Or(const BitVector& other) noexcept {
+        return Combine<bit_detail::BitOp::OR>(other);
+    }
+
+    BitVector& Xor(const BitVector& other) noexcept {
+        return Combine<bit_detail::BitOp::XOR>(other);
+    }
+
+    bool operator==(const BitVector& other) const noexcept {
+        return size_ == other.size_ && std::equal(Words(), Words() + WordCount(), other.Words());
+    }
+
+    bool operator!=(const BitVector& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    uint64_t* Words() noexcept {
+        return words_.GetAddress();
+    }
+
+    // Обнуляет биты последнего слова за Size()
+    void ClearTail() noexcept {
+        if (size_ % WORD_BITS != 0) {
+            words_[size_ / WORD_BITS] &= ~(~uint64_t{0} << (size_ % WORD_BITS));
+        }
+    }
+
+    void CopyWords(const uint64_t* words, size_t count) noexcept {
+        if (count != 0) {
+            std::memcpy(Words(), words, count * sizeof(uint64_t));
+        }
+    }
+
+    void ChangeWordCapacity(size_t word_capacity) {
+        RawMemory<uint64_t, Alloc> new_words(word_capacity, GetAllocator());
+        if (WordCount() != 0) {
+            std::memcpy(new_words.GetAddress(), Words(), WordCount() * sizeof(uint64_t));
+        }
+        words_.Swap(new_words);
+    }
+
+    size_t FindFrom(size_t pos) const noexcept {
+        size_t word = pos / WORD_BITS;
+        const uint64_t first = words_[word] & (~uint64_t{0} << (pos % WORD_BITS));
+        if (first == 0) {
+            word = bit_detail::FindNonZero(Words(), word + 1, WordCount());
+            if (word == WordCount()) {
+                return size_;
+            }
+            return word * WORD_BITS + static_cast<size_t>(__builtin_ctzll(words_[word]));
+        }
+        return word * WORD_BITS + static_cast<size_t>(__builtin_ctzll(first));
+    }
+
+    template <bit_detail::BitOp Op>
+    BitVector& Combine(const BitVector& other) noexcept {
+        assert(size_ == other.size_);
+        bit_detail::Combine<Op>(Words(), other.Words(), WordCount());
+        return *this;
+    }
+
+    RawMemory<uint64_t, Alloc> words_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Вектор, в который несколько потоков добавляют элементы без блокировок.
+// Элементы живут в сегментах размером FIRST_SEGMENT_SIZE, 2 * FIRST_SEGMENT_SIZE, 4 * ...,
+// которые выделяются по мере надобности и никогда не перемещаются, поэтому адреса стабильны.
+// Индекс резервируется атомарным счётчиком, после конструирования элемент публикуется флагом.
+// Читать можно любой элемент с индексом меньше PublishedSize() параллельно с добавлением
+template <typename T>
+class ConcurrentVector {
+    // Если конструктор бросит исключение после резервирования, в векторе останется дыра,
+    // поэтому объект сначала создаётся во временной переменной и затем перемещается,
+    // а сегмент для индекса выделяется до того, как индекс зарезервирован
+    static_assert(std::is_nothrow_move_constructible_v<T>, "ConcurrentVector requires nothrow move construction");
+
+public:
+    static constexpr size_t FIRST_SEGMENT_SIZE = 16;
+
+    ConcurrentVector() = default;
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ~ConcurrentVector() {
+        Clear();
+    }
+
+    // Зарезервировано индексов, включая элементы, которые ещё конструируются
+    [[nodiscard]] size_t Size() const noexcept {
+        return reserved_.load(std::memory_order_acquire);
+    }
+
+    // Длина префикса, все элементы которого опубликованы
+    [[nodiscard]] size_t PublishedSize() const noexcept {
+        return published_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool IsPublished(size_t index) const noexcept {
+        const auto [segment, offset] = Locate(index);
+        const Segment* data = segments_[segment].load(std::memory_order_acquire);
+        return data != nullptr && data->ready[offset].load(std::memory_order_seq_cst);
+    }
+
+    // Элемент должен быть опубликован
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<ConcurrentVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(IsPublished(index));
+        const auto [segment, offset] = Locate(index);
+        return segments_[segment].load(std::memory_order_acquire)->data[offset];
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Lock-free: потоки конкурируют за следующий индекс и за установку нового сегмента.
+    // Если конструктор или выделение сегмента бросят исключение, индекс не резервируется
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+            return Publish([&](T* slot) noexcept {
+                new (slot) T(std::forward<Args>(args)...);
+            });
+        } else {
+            T value(std::forward<Args>(args)...);
+            return Publish([&value](T* slot) noexcept {
+                new (slot) T(std::move(value));
+            });
+        }
+    }
+
+    // Переносит элементы в непрерывный Vector и опустошает контейнер.
+    // Вызывается, когда добавляющие потоки завершились; переносится только опубликованный префикс
+    Vector<T> Freeze() {
+        const size_t size = PublishedSize();
+        assert(Size() == size);
+        Vector<T> result;
+        result.Reserve(size);
+        ForEachSegment(size, [&result](Segment& segment, size_t count) {
+            T* data = segment.data.GetAddress();
+            if constexpr (std::is_trivial_v<T>) {
+                std::memcpy(result.AppendUninitialized(count), data, count * sizeof(T));
+            } else {
+                for (size_t i = 0; i < count; ++i) {
+                    result.EmplaceBack(std::move(data[i]));
+                }
+            }
+        });
+        Clear();
+        return result;
+    }
+
+    // Уничтожает элементы и освобождает сегменты. Не потокобезопасен
+    void Clear() noexcept {
+        const size_t size = Size();
+        ForEachSegment(size, [](Segment& segment, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                if (segment.ready[i].load(std::memory_order_relaxed)) {
+                    std::destroy_at(segment.data + i);
+                }
+            }
+        });
+        for (auto& segment : segments_) {
+            delete segment.exchange(nullptr, std::memory_order_acq_rel);
+        }
+        reserved_.store(0, std::memory_order_release);
+        published_.store(0, std::memory_order_release);
+    }
+
+private:
+    struct Segment {
+        explicit Segment(size_t size)
+            : data(size)
+            , ready(std::make_unique<std::atomic<bool>[]>(size))
+        {}
+
+        RawMemory<T> data;
+        std::unique_ptr<std::atomic<bool>[]> ready;
+    };
+
+    static constexpr size_t LOG_FIRST_SEGMENT_SIZE = 4;
+    static_assert(FIRST_SEGMENT_SIZE == size_t{1} << LOG_FIRST_SEGMENT_SIZE);
+    static constexpr size_t MAX_SEGMENTS = sizeof(size_t) * 8 - LOG_FIRST_SEGMENT_SIZE;
+
+    static size_t FloorLog2(size_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(value);
+#else
+        size_t result = 0;
+        while (value >>= 1) {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    static size_t SegmentSize(size_t segment) noexcept {
+        return FIRST_SEGMENT_SIZE << segment;
+    }
+
+    // Сегмент k хранит индексы [FIRST * (2^k - 1), FIRST * (2^(k+1) - 1))
+    static std::pair<size_t, size_t> Locate(size_t index) noexcept {
+        const size_t position = index + FIRST_SEGMENT_SIZE;
+        const size_t log = FloorLog2(position);
+        return {log - LOG_FIRST_SEGMENT_SIZE, position - (size_t{1} << log)};
+    }
+
+    Segment& GetOrCreateSegment(size_t segment) {
+        assert(segment < MAX_SEGMENTS);
+        Segment* current = segments_[segment].load(std::memory_order_acquire);
+        if (current != nullptr) {
+            return *current;
+        }
+        auto created = std::make_unique<Segment>(SegmentSize(segment));
+        if (segments_[segment].compare_exchange_strong(current, created.get(), std::memory_order_acq_rel,
+                                                       std::memory_order_acquire)) {
+            return *created.release();
+        }
+        // Сегмент установил другой поток, наш освобождается
+        return *current;
+    }
+
+    // Индекс занимается только после того, как его сегмент существует, а конструирование
+    // не бросает: каждый зарезервированный индекс будет опубликован
+    template <typename Construct>
+    T& Publish(Construct construct) {
+        static_assert(std::is_nothrow_invocable_v<Construct&, T*>);
+        size_t index = reserved_.load(std::memory_order_seq_cst);
+        Segment* data = nullptr;
+        size_t offset = 0;
+        do {
+            const auto [segment, segment_offset] = Locate(index);
+            data = &GetOrCreateSegment(segment);
+            offset = segment_offset;
+        } while (!reserved_.compare_exchange_weak(index, index + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_seq_cst));
+        T* slot = data->data + offset;
+        construct(slot);
+        data->ready[offset].store(true, std::memory_order_seq_cst);
+        AdvancePublished();
+        return *slot;
+    }
+
+    // Сдвигает границу опубликованного префикса; продвигать её может любой поток.
+    // Запись ready, чтение ready, reserved_ и published_ — seq_cst: с acquire/release два
+    // публикующих потока могут не увидеть записи друг друга (поток A сдвинул границу и не
+    // видит ready следующего, поток B записал ready и читает старую границу), и граница
+    // застрянет. В едином порядке seq_cst хотя бы один из них увидит запись другого
+    void AdvancePublished() noexcept {
+        size_t published = published_.load(std::memory_order_seq_cst);
+        while (published < reserved_.load(std::memory_order_seq_cst) && IsPublished(published)) {
+            if (published_.compare_exchange_weak(published, published + 1, std::memory_order_seq_cst,
+                                                 std::memory_order_seq_cst)) {
+                ++published;
+            }
+        }
+    }
+
+    // Обходит сегменты, покрывающие первые size индексов: visitor(segment, count)
+    template <typename Visitor>
+    void ForEachSegment(size_t size, Visitor visitor) {
+        for (size_t segment = 0, first = 0; first < size; first += SegmentSize(segment), ++segment) {
+            Segment* data = segments_[segment].load(std::memory_order_acquire);
+            const size_t count = std::min(SegmentSize(segment), size - first);
+            if (data != nullptr) {
+                visitor(*data, count);
+            }
+        }
+    }
+
+    std::atomic<Segment*> segments_[MAX_SEGMENTS] = {};
+    std::atomic<size_t> reserved_ = 0;
+    std::atomic<size_t> published_ = 0;
+};
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+// Вектор с копированием при записи: копии разделяют один буфер со счётчиком ссылок,
+// поэтому копирование снимка для читателей стоит O(1). Первая изменяющая операция
+// над разделяемым буфером (неконстантный operator[], PushBack, Erase, ...) делает
+// собственную копию. Счётчик атомарный: копии можно передавать в другие потоки и
+// читать, изменять и уничтожать независимо. Один объект CowVector, как и Vector,
+// не потокобезопасен
+template <typename T>
+class CowVector {
+public:
+    using iterator = typename Vector<T>::iterator;
+    using const_iterator = typename Vector<T>::const_iterator;
+
+    CowVector() = default;
+
+    explicit CowVector(size_t size)
+        : buffer_(new Buffer(Vector<T>(size)))
+    {}
+
+    // Забирает элементы без копирования
+    explicit CowVector(Vector<T>&& values)
+        : buffer_(new Buffer(std::move(values)))
+    {}
+
+    CowVector(const CowVector& other) noexcept
+        : buffer_(other.buffer_)
+    {
+        if (buffer_ != nullptr) {
+            buffer_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowVector(CowVector&& other) noexcept
+        : buffer_(std::exchange(other.buffer_, nullptr))
+    {}
+
+    CowVector& operator=(const CowVector& rhs) noexcept {
+        if (this != &rhs) {
+            CowVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    CowVector& operator=(CowVector&& rhs) noexcept {
+        if (this != &rhs) {
+            CowVector rhs_moved(std::move(rhs));
+            Swap(rhs_moved);
+        }
+        return *this;
+    }
+
+    ~CowVector() {
+        Release();
+    }
+
+    const_iterator begin() const noexcept {
+        return View().begin();
+    }
+    const_iterator end() const noexcept {
+        return View().end();
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Неконстантные итераторы отделяют буфер
+    iterator begin() {
+        return Mutable().begin();
+    }
+    iterator end() {
+        return Mutable().end();
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return View().Size();
+    }
+
+    [[nodiscard]] size_t Capacity() const noexcept {
+        return View().Capacity();
+    }
+
+    // Число векторов, разделяющих буфер; 0 у пустого вектора без буфера
+    [[nodiscard]] size_t UseCount() const noexcept {
+        return buffer_ == nullptr ? 0 : buffer_->refs.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool IsShared() const noexcept {
+        return UseCount() > 1;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return View()[index];
+    }
+
+    T& operator[](size_t index) {
+        return Mutable()[index];
+    }
+
+    // Разделяемые элементы только для чтения
+    const Vector<T>& View() const noexcept {
+        static const Vector<T> empty;
+        return buffer_ == nullptr ? empty : buffer_->values;
+    }
+
+    // Собственный буфер для изменения: копирует элементы, если буфер разделяется.
+    // Ссылка действительна до следующего копирования этого CowVector
+    Vector<T>& Mutable() {
+        CowVector previous;
+        return Detach(previous);
+    }
+
+    void Swap(CowVector& other) noexcept {
+        std::swap(buffer_, other.buffer_);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (IsShared()) {
+            // Копия сразу получает нужную ёмкость вместо копирования с последующим ростом
+            Vector<T> copy;
+            copy.Reserve(std::max(new_capacity, Size()));
+            copy.Insert(copy.cend(), cbegin(), cend());
+            *this = CowVector(std::move(copy));
+        } else {
+            Mutable().Reserve(new_capacity);
+        }
+    }
+
+    // Разделяемый буфер не копируется, а просто отпускается
+    void Clear() noexcept {
+        if (IsShared()) {
+            Release();
+            buffer_ = nullptr;
+        } else if (buffer_ != nullptr) {
+            buffer_->values.Clear();
+        }
+    }
+
+    void Resize(size_t new_size) {
+        Mutable().Resize(new_size);
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PopBack() {
+        Mutable().PopBack();
+    }
+
+    // Аргументы могут ссылаться на разделяемые элементы: старый буфер удерживается
+    // до конца операции, даже если другие копии успеют его отпустить
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        CowVector previous;
+        return Detach(previous).EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Позиции задаются итераторами этого вектора и переводятся в собственный буфер
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        const size_t offset = pos - cbegin();
+        CowVector previous;
+        Vector<T>& values = Detach(previous);
+        return values.Emplace(values.cbegin() + offset, std::forward<Args>(args)...);
+    }
+
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    iterator Erase(const_iterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    iterator Erase(const_iterator first, const_iterator last) {
+        const size_t offset = first - cbegin();
+        const size_t count = last - first;
+        Vector<T>& values = Mutable();
+        return values.Erase(values.cbegin() + offset, values.cbegin() + offset + count);
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(Vector<T>&& values)
+            : values(std::move(values))
+        {}
+
+        std::atomic<size_t> refs = 1;
+        Vector<T> values;
+    };
+
+    // Отделяет буфер, передавая ссылку на разделяемый в previous
+    Vector<T>& Detach(CowVector& previous) {
+        if (buffer_ == nullptr) {
+            buffer_ = new Buffer(Vector<T>());
+        } else if (buffer_->refs.load(std::memory_order_acquire) > 1) {
+            Buffer* copy = new Buffer(Vector<T>(buffer_->values));
+            previous.buffer_ = std::exchange(buffer_, copy);
+        }
+        return buffer_->values;
+    }
+
+    // Последний владелец освобождает буфер; acq_rel упорядочивает чтения
+    // остальных владельцев до уничтожения элементов
+    void Release() noexcept {
+        if (buffer_ != nullptr && buffer_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete buffer_;
+        }
+    }
+
+    Buffer* buffer_ = nullptr;
+};
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Вектор с зазором (gap buffer): свободная часть буфера стоит в месте последней правки,
+// поэтому серия вставок и удалений рядом с курсором стоит O(расстояния, на которое сдвинулся
+// курсор), а не O(n). Элементы лежат в [0, gap_begin) и [gap_end, capacity).
+// Непрерывный массив элементов возвращает Compact(), переносящий зазор в конец
+template <typename T>
+class GapVector {
+public:
+    GapVector() = default;
+
+    explicit GapVector(size_t size)
+        : buffer_(size)
+        , gap_begin_(size)
+        , gap_end_(size)
+    {
+        std::uninitialized_value_construct_n(buffer_.GetAddress(), size);
+    }
+
+    GapVector(const GapVector& other)
+        : buffer_(other.Size())
+        , gap_begin_(other.Size())
+        , gap_end_(other.Size())
+    {
+        T* copied_end = std::uninitialized_copy_n(other.buffer_.GetAddress(), other.gap_begin_, buffer_.GetAddress());
+        try {
+            std::uninitialized_copy_n(other.buffer_ + other.gap_end_, other.Capacity() - other.gap_end_, copied_end);
+        } catch (...) {
+            std::destroy(buffer_.GetAddress(), copied_end);
+            throw;
+        }
+    }
+
+    GapVector(GapVector&& other) noexcept
+        : buffer_(std::move(other.buffer_))
+        , gap_begin_(std::exchange(other.gap_begin_, 0))
+        , gap_end_(std::exchange(other.gap_end_, 0))
+    {}
+
+    GapVector& operator=(const GapVector& rhs) {
+        if (this != &rhs) {
+            GapVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    GapVector& operator=(GapVector&& rhs) noexcept {
+        if (this != &rhs) {
+            GapVector rhs_moved(std::move(rhs));
+            Swap(rhs_moved);
+        }
+        return *this;
+    }
+
+    ~GapVector() {
+        DestroyElements();
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return Capacity() - GapSize();
+    }
+
+    [[nodiscard]] size_t Capacity() const noexcept {
+        return buffer_.Capacity();
+    }
+
+    // Позиция зазора: индекс, перед которым вставка не сдвигает элементов
+    [[nodiscard]] size_t GapPosition() const noexcept {
+        return gap_begin_;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<GapVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        return buffer_[index < gap_begin_ ? index : index + GapSize()];
+    }
+
+    void Swap(GapVector& other) noexcept {
+        buffer_.Swap(other.buffer_);
+        std::swap(gap_begin_, other.gap_begin_);
+        std::swap(gap_end_, other.gap_end_);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > Capacity()) {
+            Grow(new_capacity);
+        }
+    }
+
+    void Clear() noexcept {
+        DestroyElements();
+        gap_begin_ = 0;
+        gap_end_ = Capacity();
+    }
+
+    // Переносит зазор в конец и возвращает непрерывный массив из Size() элементов
+    T* Compact() {
+        MoveGap(Size());
+        return buffer_.GetAddress();
+    }
+
+    template <typename... Args>
+    T& Emplace(size_t index, Args&&... args) {
+        assert(index <= Size());
+        if (index == gap_begin_ && GapSize() > 0) {
+            new (buffer_ + gap_begin_) T(std::forward<Args>(args)...);
+        } else {
+            // Аргументы могут ссылаться на элементы, которые сдвинутся вместе с зазором
+            T value(std::forward<Args>(args)...);
+            if (GapSize() == 0) {
+                Grow(std::max<size_t>(Capacity() * 2, 1));
+            }
+            MoveGap(index);
+            new (buffer_ + gap_begin_) T(std::move(value));
+        }
+        return buffer_[gap_begin_++];
+    }
+
+    void Insert(size_t index, const T& value) {
+        Emplace(index, value);
+    }
+
+    void Insert(size_t index, T&& value) {
+        Emplace(index, std::move(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        return Emplace(Size(), std::forward<Args>(args)...);
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Удаляет элемент index; зазор встаёт на его место
+    void Erase(size_t index) {
+        assert(index < Size());
+        MoveGap(index);
+        std::destroy_at(buffer_ + gap_end_);
+        ++gap_end_;
+    }
+
+    void PopBack() {
+        Erase(Size() - 1);
+    }
+
+private:
+    size_t GapSize() const noexcept {
+        return gap_end_ - gap_begin_;
+    }
+
+    void DestroyElements() noexcept {
+        std::destroy_n(buffer_.GetAddress(), gap_begin_);
+        std::destroy(buffer_ + gap_end_, buffer_ + Capacity());
+    }
+
+    // Переносит элементы в буфер new_capacity, сохраняя позицию зазора
+    void Grow(size_t new_capacity) {
+        RawMemory<T> new_buffer(new_capacity);
+        const size_t tail = Capacity() - gap_end_;
+        const size_t new_gap_end = new_capacity - tail;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            vector_detail::Relocate(buffer_.GetAddress(), gap_begin_, new_buffer.GetAddress());
+            vector_detail::Relocate(buffer_ + gap_end_, tail, new_buffer + new_gap_end);
+        } else {
+            vector_detail::UninitializedMoveOrCopyN(buffer_.GetAddress(), gap_begin_, new_buffer.GetAddress());
+            try {
+                vector_detail::UninitializedMoveOrCopyN(buffer_ + gap_end_, tail, new_buffer + new_gap_end);
+            } catch (...) {
+                std::destroy_n(new_buffer.GetAddress(), gap_begin_);
+                throw;
+            }
+            DestroyElements();
+        }
+        buffer_.Swap(new_buffer);
+        gap_end_ = new_gap_end;
+    }
+
+    // Сдвигает зазор так, чтобы он начинался с логического индекса index. Если перемещение
+    // элемента бросит исключение, зазор остаётся там, куда успел дойти, и порядок не нарушается
+    void MoveGap(size_t index) {
+        const size_t gap = GapSize();
+        if (index == gap_begin_ || gap == 0) {
+            gap_begin_ = index;
+            gap_end_ = index + gap;
+            return;
+        }
+        if constexpr (is_trivially_relocatable_v<T>) {
+            if (index < gap_begin_) {
+                std::memmove(static_cast<void*>(buffer_ + index + gap), static_cast<const void*>(buffer_ + index),
+                             (gap_begin_ - index) * sizeof(T));
+            } else {
+                std::memmove(static_cast<void*>(buffer_ + gap_begin_), static_cast<const void*>(buffer_ + gap_end_),
+                             (index - gap_begin_) * sizeof(T));
+            }
+            gap_begin_ = index;
+            gap_end_ = index + gap;
+        } else if (index < gap_begin_) {
+            // Элементы перед зазором переезжают в его конец, справа налево
+            while (gap_begin_ > index) {
+                MoveElement(gap_begin_ - 1, gap_end_ - 1);
+                --gap_begin_;
+                --gap_end_;
+            }
+        } else {
+            while (gap_begin_ < index) {
+                MoveElement(gap_end_, gap_begin_);
+                ++gap_begin_;
+                ++gap_end_;
+            }
+        }
+    }
+
+    void MoveElement(size_t from, size_t to) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            new (buffer_ + to) T(std::move(buffer_[from]));
+        } else {
+            new (buffer_ + to) T(buffer_[from]);
+        }
+        std::destroy_at(buffer_ + from);
+    }
+
+    RawMemory<T> buffer_;
+    size_t gap_begin_ = 0;
+    size_t gap_end_ = 0;
+};
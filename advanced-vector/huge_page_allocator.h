@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+inline constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+
+// Аллокатор, отдающий буферы от Threshold байт на огромных страницах по 2 МБ:
+// сначала через MAP_HUGETLB, а если в системе нет зарезервированных страниц —
+// через выровненный по 2 МБ mmap с madvise(MADV_HUGEPAGE) (transparent huge pages).
+// Буферы меньше порога и платформы без mmap используют обычный operator new.
+// Все буферы вектора, включая новые при реаллокации, выделяются так же
+template <typename T, size_t Threshold = HUGE_PAGE_SIZE>
+class HugePageAllocator {
+    static_assert(alignof(T) <= HUGE_PAGE_SIZE, "Alignment exceeds huge page size");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = HugePageAllocator<U, Threshold>;
+    };
+
+    HugePageAllocator() noexcept = default;
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U, Threshold>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n * sizeof(T);
+        if (!IsMapped(bytes)) {
+            return static_cast<T*>(operator new(bytes, std::align_val_t{alignof(T)}));
+        }
+        void* ptr = Map(RoundUpToHugePage(bytes));
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (!IsMapped(bytes)) {
+            operator delete(p, std::align_val_t{alignof(T)});
+            return;
+        }
+#ifdef __linux__
+        munmap(p, RoundUpToHugePage(bytes));
+#endif
+    }
+
+    bool operator==(const HugePageAllocator&) const noexcept {
+        return true;
+    }
+
+    bool operator!=(const HugePageAllocator&) const noexcept {
+        return false;
+    }
+
+private:
+    static bool IsMapped([[maybe_unused]] size_t bytes) noexcept {
+#ifdef __linux__
+        return bytes >= Threshold;
+#else
+        return false;
+#endif
+    }
+
+    static size_t RoundUpToHugePage(size_t bytes) noexcept {
+        return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+
+#ifdef __linux__
+    static void* Map(size_t length) noexcept {
+#ifdef MAP_HUGETLB
+        // После первой неудачи MAP_HUGETLB больше не пробуем
+        static std::atomic<bool> hugetlb_available = true;
+        if (hugetlb_available.load(std::memory_order_relaxed)) {
+            void* ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr != MAP_FAILED) {
+                return ptr;
+            }
+            hugetlb_available.store(false, std::memory_order_relaxed);
+        }
+#endif
+        return MapTransparent(length);
+    }
+
+    // Выделяет с запасом в одну огромную страницу и обрезает края до выровненного окна
+    static void* MapTransparent(size_t length) noexcept {
+        void* raw = mmap(nullptr, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            return nullptr;
+        }
+        const auto begin = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned = (begin + HUGE_PAGE_SIZE - 1) & ~(uintptr_t{HUGE_PAGE_SIZE} - 1);
+        if (aligned != begin) {
+            munmap(raw, aligned - begin);
+        }
+        const uintptr_t tail = aligned + length;
+        const uintptr_t end = begin + length + HUGE_PAGE_SIZE;
+        if (tail != end) {
+            munmap(reinterpret_cast<void*>(tail), end - tail);
+        }
+        void* ptr = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+        madvise(ptr, length, MADV_HUGEPAGE);
+#endif
+        return ptr;
+    }
+#else
+    static void* Map(size_t) noexcept {
+        return nullptr;
+    }
+#endif
+};
@@ -1,10 +1,46 @@
 #include "vector.h"
+#include "aligned_allocator.h"
+#include "bit_vector.h"
+#include "concurrent_vector.h"
+#include "cow_vector.h"
+#include "gap_vector.h"
+#include "huge_page_allocator.h"
+#include "mapped_vector.h"
+#include "numa_allocator.h"
+#include "parallel_sort.h"
+#include "pool_allocator.h"
+#include "realloc_allocator.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "stable_vector.h"
+#include "static_vector.h"
+#include "usable_size_allocator.h"
+#include "vector_stats.h"
+#include "vector_io.h"
+#include "vector_reclaim.h"
+#include "vector_simd.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <numeric>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
 #include <vector>
 
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 namespace {
 
 // "Магическое" число, используемое для отслеживания живости объекта
@@ -558,87 +594,2295 @@ void Test6() {
     }
 }
 
-struct C {
-    C() noexcept {
-        ++def_ctor;
+namespace {
+
+// Аллокатор с состоянием: считает выделения и различается по id
+template <typename T, bool Propagate>
+struct TrackingAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_swap = std::bool_constant<Propagate>;
+    using is_always_equal = std::false_type;
+
+    explicit TrackingAllocator(int alloc_id = 0) noexcept
+        : id(alloc_id)
+    {}
+
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U, Propagate>& other) noexcept
+        : id(other.id)
+    {}
+
+    T* allocate(size_t n) {
+        ++num_allocations;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        ++num_deallocations;
+        std::allocator<T>{}.deallocate(p, n);
     }
-    C(const C& /*other*/) noexcept {
-        ++copy_ctor;
+
+    bool operator==(const TrackingAllocator& other) const noexcept {
+        return id == other.id;
     }
-    C(C&& /*other*/) noexcept {
-        ++move_ctor;
+    bool operator!=(const TrackingAllocator& other) const noexcept {
+        return id != other.id;
     }
-    C& operator=(const C& other) noexcept {
-        if (this != &other) {
-            ++copy_assign;
+
+    int id = 0;
+
+    static inline int num_allocations = 0;
+    static inline int num_deallocations = 0;
+};
+
+}  // namespace
+
+void Test7() {
+    const size_t SIZE = 100;
+    const int ID = 42;
+    {
+        // Аллокатор без состояния не увеличивает размер
+        static_assert(sizeof(Vector<int>) == sizeof(int*) + 2 * sizeof(size_t));
+        static_assert(sizeof(RawMemory<int>) == sizeof(int*) + sizeof(size_t));
+    }
+    {
+        Obj::ResetCounters();
+        std::pmr::monotonic_buffer_resource arena;
+        {
+            using PmrVector = Vector<Obj, std::pmr::polymorphic_allocator<Obj>>;
+            PmrVector v(&arena);
+            for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+                v.EmplaceBack(i);
+            }
+            assert(v.Size() == SIZE);
+            assert(v.GetAllocator().resource() == &arena);
+
+            PmrVector v_copy(v);
+            assert(v_copy.GetAllocator().resource() == std::pmr::get_default_resource());
+            assert(v_copy[SIZE - 1].id == static_cast<int>(SIZE - 1));
+
+            std::pmr::monotonic_buffer_resource other_arena;
+            PmrVector v_other(&other_arena);
+            v_other = std::move(v);
+            assert(v_other.GetAllocator().resource() == &other_arena);
+            assert(v_other.Size() == SIZE);
+            assert(v_other[ID].id == ID);
         }
-        return *this;
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        using Alloc = TrackingAllocator<Obj, true>;
+        Obj::ResetCounters();
+        Vector<Obj, Alloc> v(SIZE, Alloc{1});
+        Vector<Obj, Alloc> v_other(SIZE / 2, Alloc{2});
+        v_other = v;
+        assert(v_other.GetAllocator().id == 1);
+        assert(v_other.Size() == SIZE);
+
+        Vector<Obj, Alloc> v_moved(Alloc{3});
+        v_moved = std::move(v);
+        assert(v_moved.GetAllocator().id == 1);
+        assert(v_moved.Size() == SIZE);
+        assert(v.Size() == 0);
+
+        Vector<Obj, Alloc> v_small(1, Alloc{3});
+        v_moved.Swap(v_small);
+        assert(v_small.GetAllocator().id == 1);
+        assert(v_moved.GetAllocator().id == 3);
+        assert(v_small.Size() == SIZE);
+        assert(v_moved.Size() == 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        using Alloc = TrackingAllocator<Obj, false>;
+        Obj::ResetCounters();
+        {
+            Vector<Obj, Alloc> v(SIZE, Alloc{1});
+            Vector<Obj, Alloc> v_other(Alloc{2});
+            const int old_num_moved = Obj::num_moved;
+            // Неравные аллокаторы без распространения: элементы перемещаются по одному
+            v_other = std::move(v);
+            assert(v_other.GetAllocator().id == 2);
+            assert(v_other.Size() == SIZE);
+            assert(Obj::num_moved == old_num_moved + static_cast<int>(SIZE));
+
+            Vector<Obj, Alloc> v_copy(v_other);
+            assert(v_copy.GetAllocator().id == 2);
+            v_copy.Reserve(SIZE * 2);
+            assert(v_copy.GetAllocator().id == 2);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+        assert(Alloc::num_allocations == Alloc::num_deallocations);
+    }
+}
+
+// Владеющий дескриптор, объявленный тривиально перемещаемым
+struct Handle {
+    explicit Handle(int value)
+        : ptr(new int(value))
+    {}
+    Handle(Handle&& other) noexcept
+        : ptr(std::exchange(other.ptr, nullptr))
+    {
+        ++num_moved;
     }
-    C& operator=(C&& /*other*/) noexcept {
-        ++move_assign;
+    Handle& operator=(Handle&& other) noexcept {
+        std::swap(ptr, other.ptr);
+        ++num_moved;
         return *this;
     }
-    ~C() {
-        ++dtor;
+    ~Handle() {
+        delete ptr;
+        ++num_destroyed;
+    }
+
+    int* ptr = nullptr;
+
+    static inline int num_moved = 0;
+    static inline int num_destroyed = 0;
+};
+
+template <>
+struct is_trivially_relocatable<Handle> : std::true_type {};
+
+void Test8() {
+    const size_t SIZE = 100;
+    const int ID = 42;
+    {
+        static_assert(is_trivially_relocatable_v<int>);
+        static_assert(!is_trivially_relocatable_v<std::string>);
+
+        Vector<int> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.PushBack(i);
+        }
+        v.Insert(v.cbegin() + 1, ID);
+        v.Reserve(SIZE * 4);
+        assert(v.Size() == SIZE + 1);
+        assert(v[0] == 0 && v[1] == ID && v[2] == 1 && v[SIZE] == static_cast<int>(SIZE - 1));
+        v.Erase(v.cbegin());
+        assert(v[0] == ID && v[1] == 1);
+        assert(v.Size() == SIZE);
+    }
+    {
+        Vector<Handle> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(Handle::num_moved == 0);
+        assert(Handle::num_destroyed == 0);
+
+        v.Reserve(SIZE * 2);
+        v.Emplace(v.cbegin() + 1, ID);
+        v.Erase(v.cbegin() + 2);
+        // Сдвиги и реаллокации не вызывают конструкторов и деструкторов,
+        // кроме перемещения временного объекта при вставке в середину
+        assert(Handle::num_moved == 1);
+        assert(Handle::num_destroyed == 2);
+        assert(v.Size() == SIZE);
+        assert(*v[0].ptr == 0 && *v[1].ptr == ID && *v[2].ptr == 2);
+        assert(*v[SIZE - 1].ptr == static_cast<int>(SIZE - 1));
+    }
+    assert(Handle::num_destroyed == static_cast<int>(SIZE) + 2);
+}
+
+namespace {
+
+// ReallocAllocator, считающий вызовы allocate и reallocate
+template <typename T>
+struct CountingReallocAllocator {
+    using value_type = T;
+
+    CountingReallocAllocator() noexcept = default;
+
+    template <typename U>
+    CountingReallocAllocator(const CountingReallocAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        ++num_allocations;
+        return ReallocAllocator<T>{}.allocate(n);
+    }
+
+    T* reallocate(T* p, size_t old_n, size_t new_n) {
+        ++num_reallocations;
+        return ReallocAllocator<T>{}.reallocate(p, old_n, new_n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        ReallocAllocator<T>{}.deallocate(p, n);
     }
 
-    static void Reset() {
-        def_ctor = 0;
-        copy_ctor = 0;
-        move_ctor = 0;
-        copy_assign = 0;
-        move_assign = 0;
-        dtor = 0;
+    bool operator==(const CountingReallocAllocator&) const noexcept {
+        return true;
+    }
+    bool operator!=(const CountingReallocAllocator&) const noexcept {
+        return false;
     }
 
-    inline static size_t def_ctor = 0;
-    inline static size_t copy_ctor = 0;
-    inline static size_t move_ctor = 0;
-    inline static size_t copy_assign = 0;
-    inline static size_t move_assign = 0;
-    inline static size_t dtor = 0;
+    static inline int num_allocations = 0;
+    static inline int num_reallocations = 0;
 };
 
-void Dump() {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-         << ", Copy ctors: "sv << C::copy_ctor          //
-         << ", Move ctors: "sv << C::move_ctor          //
-         << ", Copy assignments: "sv << C::copy_assign  //
-         << ", Move assignments: "sv << C::move_assign  //
-         << ", Dtors: "sv << C::dtor << endl;
+}  // namespace
+
+void Test9() {
+    // Небольшой порог, чтобы пройти через realloc, переход на mmap и mremap
+    const size_t THRESHOLD = 1 << 16;
+    const size_t SIZE = 100'000;
+    {
+        Vector<int, ReallocAllocator<int, THRESHOLD>> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Size() == SIZE);
+        v.Insert(v.cbegin(), -1);
+        v.Reserve(SIZE * 4);
+        assert(v.Capacity() == SIZE * 4);
+        assert(v[0] == -1);
+        for (size_t i = 1; i < v.Size(); ++i) {
+            assert(v[i] == static_cast<int>(i - 1));
+        }
+    }
+    Handle::num_moved = 0;
+    Handle::num_destroyed = 0;
+    {
+        Vector<Handle, ReallocAllocator<Handle, THRESHOLD>> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.EmplaceBack(i);
+        }
+        // При росте на месте перемещается только вставляемый объект
+        assert(Handle::num_moved < 32);
+        assert(*v[SIZE - 1].ptr == static_cast<int>(SIZE - 1));
+        Vector<Handle, ReallocAllocator<Handle, THRESHOLD>> v_moved(std::move(v));
+        assert(v_moved.Size() == SIZE);
+    }
+    assert(Handle::num_destroyed == static_cast<int>(SIZE) + Handle::num_moved);
+    {
+        // Вставка нескольких элементов за пределы ёмкости растит буфер через reallocate
+        using Alloc = CountingReallocAllocator<int>;
+        Vector<int, Alloc> v;
+        v.Insert(v.cend(), {1, 2, 3});
+        v.ShrinkToFit();
+        assert(v.Capacity() == 3);
+        const int allocations = Alloc::num_allocations;
+        const int reallocations = Alloc::num_reallocations;
+
+        v.Insert(v.cbegin() + 1, {10, 11});
+        assert(v.Size() == 5);
+        assert(v[0] == 1 && v[1] == 10 && v[2] == 11 && v[3] == 2 && v[4] == 3);
+        const size_t filled = v.Capacity();
+        v.Insert(v.cbegin(), filled, 7);
+        assert(std::count(v.begin(), v.begin() + filled, 7) == static_cast<long>(filled));
+        assert(v[filled] == 1 && v[filled + 1] == 10 && v[filled + 4] == 3);
+        const std::vector<int> source(v.Capacity(), -1);
+        v.Insert(v.cend(), source.begin(), source.end());
+        assert(v.Size() == filled + 5 + source.size());
+        assert(v[filled + 4] == 3 && v[v.Size() - 1] == -1);
+        assert(Alloc::num_allocations == allocations);
+        assert(Alloc::num_reallocations == reallocations + 3);
+    }
 }
 
-void Benchmark() {
-    using namespace std;
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
+void Test10() {
+    {
+        assert(DoublingGrowth::NextCapacity(0, sizeof(int)) == 1);
+        assert(DoublingGrowth::NextCapacity(10, sizeof(int)) == 20);
+
+        using Growth = GeometricGrowth<3, 2, 64>;
+        assert(Growth::NextCapacity(0, sizeof(int)) == 16);
+        assert(Growth::NextCapacity(0, 100) == 1);
+        assert(Growth::NextCapacity(16, sizeof(int)) == 24);
+        assert(Growth::NextCapacity(101, sizeof(int)) == 151);
+
+        using SizeClass = SizeClassGrowth<GeometricGrowth<3, 2, 64>, 4096>;
+        assert(SizeClass::NextCapacity(16, sizeof(int)) == 32);
+        assert(SizeClass::NextCapacity(1000, sizeof(int)) == 2048);
+        assert(SizeClass::NextCapacity(0, 24) == 5);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj, std::allocator<Obj>, GeometricGrowth<3, 2>> v;
+        v.EmplaceBack(1);
+        assert(v.Capacity() == (64 + sizeof(Obj) - 1) / sizeof(Obj));
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i);
         }
-        Dump();
-    } catch (...) {
+        assert(v.Size() == 101);
+        assert(v[100].id == 99);
     }
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test11() {
+    using namespace std::literals;
+    const size_t SIZE = 10;
+    const int ID = 42;
+    {
+        Vector<int> v;
+        v.PushBack(1);
+        v.PushBack(5);
+        const std::vector<int> middle{2, 3, 4};
+        auto* pos = v.Insert(v.cbegin() + 1, middle.begin(), middle.end());
+        assert(pos == v.begin() + 1);
+        assert(v.Size() == 5);
+        for (int i = 0; i < 5; ++i) {
+            assert(v[i] == i + 1);
+        }
+        v.Insert(v.cend(), {6, 7});
+        v.Insert(v.cbegin(), 2, 0);
+        assert(v.Size() == 9);
+        assert(v[0] == 0 && v[1] == 0 && v[2] == 1 && v[8] == 7);
+
+        std::istringstream input("8 9 10"s);
+        v.Insert(v.cend(), std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(v.Size() == 12 && v[11] == 10);
+    }
+    {
+        // Вставка одного большого диапазона реаллоцирует память не больше одного раза
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        std::vector<Obj> batch(SIZE * 10);
+        batch.back().id = ID;
+        const int old_num_copied = Obj::num_copied;
+        v.Insert(v.cbegin() + 1, batch.begin(), batch.end());
+        assert(v.Size() == SIZE * 11);
+        assert(v.Capacity() == SIZE * 11);
+        assert(v[SIZE * 10].id == ID);
+        assert(Obj::num_copied == old_num_copied + static_cast<int>(SIZE * 10));
+        assert(Obj::num_moved == static_cast<int>(SIZE));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Без реаллокации хвост сдвигается один раз: вставка короче хвоста
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        v[SIZE - 1].id = ID;
+        Obj::ResetCounters();
+        v.Insert(v.cbegin() + 2, 3, Obj{1});
+        assert(v.Size() == SIZE + 3);
+        assert(v[2].id == 1 && v[4].id == 1 && v[5].id == 0);
+        assert(v[SIZE + 2].id == ID);
+        assert(Obj::num_moved == 3);
+        assert(Obj::num_move_assigned == static_cast<int>(SIZE) - 2 - 3);
+        assert(Obj::num_assigned == 3);
+    }
+    {
+        // Вставка длиннее хвоста
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        v[SIZE - 1].id = ID;
+        const std::vector<Obj> batch(5, Obj{1});
+        const int old_num_moved = Obj::num_moved;
+        v.Insert(v.cbegin() + SIZE - 2, batch.begin(), batch.end());
+        assert(v.Size() == SIZE + 5);
+        assert(v[SIZE - 2].id == 1 && v[SIZE + 2].id == 1);
+        assert(v[SIZE + 4].id == ID);
+        assert(Obj::num_moved == old_num_moved + 2);
+        assert(Obj::num_move_assigned == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<std::string> v;
+        v.Append(std::vector<std::string>{"a"s, "b"s});
+        v.Append(std::vector<std::string>{"c"s});
+        assert(v.Size() == 3 && v[0] == "a"s && v[2] == "c"s);
+        v.Insert(v.cbegin() + 1, 2, v[2]);
+        assert(v.Size() == 5 && v[1] == "c"s && v[2] == "c"s && v[3] == "b"s);
+    }
+    {
+        // Тривиально перемещаемый хвост сдвигается через memmove
+        Vector<int> v(SIZE);
+        v.Reserve(SIZE * 2);
+        v[SIZE - 1] = ID;
+        const int values[] = {1, 2, 3};
+        v.Insert(v.cbegin() + 1, std::begin(values), std::end(values));
+        assert(v.Size() == SIZE + 3 && v[1] == 1 && v[3] == 3 && v[SIZE + 2] == ID);
+    }
+}
+
+void Test12() {
+    const size_t SIZE = 10;
+    const int ID = 42;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        auto* pos = v.Erase(v.cbegin() + 2, v.cbegin() + 5);
+        assert(pos == v.begin() + 2);
+        assert(v.Size() == SIZE - 3);
+        assert(v[1].id == 1 && v[2].id == 5 && v[SIZE - 4].id == static_cast<int>(SIZE - 1));
+        assert(Obj::num_move_assigned == static_cast<int>(SIZE) - 5);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE) - 3);
+
+        const int move_assigned = Obj::num_move_assigned;
+        pos = v.Erase(v.cbegin() + 1, v.cbegin() + 1);
+        assert(pos == v.begin() + 1);
+        assert(v.Size() == SIZE - 3 && Obj::num_move_assigned == move_assigned);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Пустой диапазон не трогает элементы: перемещение в себя испортило бы строки
+        Vector<std::string> v;
+        for (const char* value : {"alpha", "beta", "gamma", "delta"}) {
+            v.PushBack(value);
+        }
+        auto* pos = v.Erase(v.begin() + 1, v.begin() + 1);
+        assert(pos == v.begin() + 1 && v.Size() == 4);
+        assert(v[0] == "alpha" && v[1] == "beta" && v[2] == "gamma" && v[3] == "delta");
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        const size_t removed = v.EraseIf([](const Obj& obj) {
+            return obj.id % 2 == 1;
+        });
+        assert(removed == SIZE / 2);
+        assert(v.Size() == SIZE / 2);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i].id == static_cast<int>(i * 2));
+        }
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE / 2));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v[SIZE - 1].id = ID;
+        auto* pos = v.EraseUnordered(v.cbegin() + 1);
+        assert(pos->id == ID);
+        assert(v.Size() == SIZE - 1);
+        assert(Obj::num_move_assigned == 1);
+        v.EraseUnordered(v.cend() - 1);
+        assert(v.Size() == SIZE - 2);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE) - 2);
+    }
+    {
+        Vector<int> v;
+        v.Insert(v.cend(), {1, 2, 3, 4, 5});
+        v.EraseUnordered(v.cbegin());
+        assert(v.Size() == 4 && v[0] == 5);
+        v.Erase(v.cbegin(), v.cend());
+        assert(v.Size() == 0);
+    }
+}
+
+void Test13() {
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE, default_init_tag);
+        assert(v.Size() == SIZE);
+        assert(Obj::num_default_constructed == SIZE);
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(v.Size() == SIZE * 2);
+        assert(Obj::num_default_constructed == SIZE * 2);
+        v.ResizeDefaultInit(SIZE / 2);
+        assert(Obj::GetAliveObjectCount() == SIZE / 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<char> v(SIZE, default_init_tag);
+        assert(v.Size() == SIZE);
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(v.Size() == SIZE * 2);
+    }
+    {
+        Vector<char> buffer;
+        buffer.PushBack('a');
+        char* tail = buffer.AppendUninitialized(3);
+        assert(tail == buffer.begin() + 1);
+        std::memcpy(tail, "bcd", 3);
+        assert(buffer.Size() == 4);
+        assert(std::string(buffer.begin(), buffer.end()) == "abcd");
+
+        tail = buffer.AppendUninitialized(SIZE);
+        assert(buffer.Size() == SIZE + 4);
+        assert(buffer.Capacity() >= SIZE + 4);
+        assert(tail == buffer.begin() + 4);
+        assert(buffer[3] == 'd');
+    }
+}
+
+void Test14() {
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Clear();
+        assert(v.Size() == 0);
+        assert(v.Capacity() == SIZE);
+        assert(Obj::GetAliveObjectCount() == 0);
+
+        v.Resize(SIZE / 2);
+        v[SIZE / 2 - 1].id = 1;
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE / 2);
+        assert(v[SIZE / 2 - 1].id == 1);
+        assert(Obj::GetAliveObjectCount() == SIZE / 2);
+
+        v.Clear();
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+    }
+    {
+        Vector<int, ReallocAllocator<int>> v(SIZE);
+        v.Resize(SIZE / 4);
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE / 4);
+        v.Clear();
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+    }
+    {
+        const size_t CYCLES = 3;
+        HighWaterMarkPolicy policy(4, CYCLES);
+        Vector<int> scratch;
+        scratch.Resize(SIZE * 10);
+        policy.Clear(scratch);
+        assert(scratch.Capacity() == SIZE * 10);
+
+        // Обычные запросы намного меньше выброса
+        for (size_t i = 0; i < CYCLES - 1; ++i) {
+            scratch.Resize(SIZE + i);
+            policy.Clear(scratch);
+            assert(scratch.Capacity() == SIZE * 10);
+        }
+        scratch.Resize(SIZE / 2);
+        policy.Clear(scratch);
+        assert(scratch.Size() == 0);
+        assert(scratch.Capacity() == SIZE + CYCLES - 2);
+
+        scratch.Resize(SIZE);
+        policy.Clear(scratch);
+        assert(scratch.Capacity() == SIZE + CYCLES - 2);
+    }
+}
+
+void Test15() {
+    const size_t N = 8;
+    const size_t SIZE = 100;
+    const int ID = 42;
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, N> v;
+        assert(v.IsInline());
+        assert(v.Capacity() == N);
+        for (size_t i = 0; i < N; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(v.IsInline());
+        assert(Obj::num_moved == 0);
+        v.EmplaceBack(ID);
+        assert(!v.IsInline());
+        assert(v.Capacity() == N * 2);
+        assert(v.Size() == N + 1);
+        assert(v[0].id == 0 && v[N].id == ID);
+        assert(Obj::num_moved == static_cast<int>(N));
+
+        v.Insert(v.cbegin() + 1, Obj{ID});
+        v.Erase(v.cbegin());
+        assert(v[0].id == ID && v[1].id == 1);
+        assert(Obj::GetAliveObjectCount() == N + 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Строгая гарантия при исключении, как у Vector (Test2)
+        Obj::ResetCounters();
+        Obj::default_construction_throw_countdown = N / 2;
+        try {
+            SmallVector<Obj, N> v(N);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+
+        Obj::ResetCounters();
+        SmallVector<Obj, N> v(SIZE);
+        try {
+            v[SIZE / 2].throw_on_copy = true;
+            SmallVector<Obj, N> v_copy(v);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+            assert(Obj::num_copied == SIZE / 2);
         }
-        Dump();
-    } catch (...) {
+        assert(Obj::GetAliveObjectCount() == SIZE);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, N> v_inline(N / 2);
+        v_inline[0].id = 1;
+        SmallVector<Obj, N> v_heap(SIZE);
+        v_heap[0].id = 2;
+
+        SmallVector<Obj, N> v_moved(std::move(v_inline));
+        assert(v_moved.IsInline() && v_moved.Size() == N / 2 && v_moved[0].id == 1);
+        assert(v_inline.Size() == 0);
+        SmallVector<Obj, N> v_stolen(std::move(v_heap));
+        assert(!v_stolen.IsInline() && v_stolen.Size() == SIZE && v_stolen[0].id == 2);
+
+        // Обмен векторами в разных режимах
+        v_moved.Swap(v_stolen);
+        assert(!v_moved.IsInline() && v_moved.Size() == SIZE && v_moved[0].id == 2);
+        assert(v_stolen.IsInline() && v_stolen.Size() == N / 2 && v_stolen[0].id == 1);
+        v_stolen.Swap(v_moved);
+        assert(v_stolen.Size() == SIZE && v_moved.Size() == N / 2 && v_moved[0].id == 1);
+
+        SmallVector<Obj, N> v_small(1);
+        v_small[0].id = 3;
+        v_small.Swap(v_moved);
+        assert(v_small.Size() == N / 2 && v_small[0].id == 1);
+        assert(v_moved.Size() == 1 && v_moved[0].id == 3);
+
+        v_stolen = v_small;
+        assert(v_stolen.Size() == N / 2 && v_stolen[0].id == 1);
+        v_small = std::move(v_stolen);
+        assert(v_small.Size() == N / 2);
+        v_small.Resize(SIZE);
+        v_moved = v_small;
+        assert(v_moved.Size() == SIZE && !v_moved.IsInline());
+        assert(Obj::GetAliveObjectCount() == SIZE * 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        SmallVector<TestObj, N> v(N);
+        // Вставка существующего элемента безопасна и при переходе в кучу
+        v.PushBack(v[0]);
+        v.Insert(v.cbegin() + 2, v[0]);
+        assert(std::all_of(v.begin(), v.end(), [](const TestObj& obj) {
+            return obj.IsAlive();
+        }));
     }
 }
 
+// Тип, перемещение которого может бросить исключение
+struct ThrowingMoveObj {
+    ThrowingMoveObj() = default;
+    ThrowingMoveObj(const ThrowingMoveObj&) = default;
+    ThrowingMoveObj(ThrowingMoveObj&& /*other*/) noexcept(false) {}
+    ThrowingMoveObj& operator=(const ThrowingMoveObj&) = default;
+
+    int id = 0;
+};
+
+struct alignas(128) OverAligned {
+    float values[4] = {};
+};
+
+void Test16() {
+    const size_t SIZE = 100;
+    {
+        // Выравнивание больше __STDCPP_DEFAULT_NEW_ALIGNMENT__ учитывается автоматически
+        static_assert(alignof(OverAligned) > __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        Vector<OverAligned> v(1);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(OverAligned{});
+            assert(reinterpret_cast<uintptr_t>(v.begin()) % alignof(OverAligned) == 0);
+        }
+        SmallVector<OverAligned, 2> small(1);
+        assert(reinterpret_cast<uintptr_t>(small.begin()) % alignof(OverAligned) == 0);
+    }
+    {
+        AlignedVector<float, 64> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(reinterpret_cast<uintptr_t>(v.begin()) % 64 == 0);
+        }
+        AlignedVector<float, 64> v_copy(v);
+        assert(reinterpret_cast<uintptr_t>(v_copy.begin()) % 64 == 0);
+        assert(v_copy[SIZE - 1] == static_cast<float>(SIZE - 1));
+
+        AlignedVector<double, 4096> page_aligned(SIZE);
+        assert(reinterpret_cast<uintptr_t>(page_aligned.begin()) % 4096 == 0);
+        static_assert(sizeof(AlignedVector<float>) == sizeof(Vector<float>));
+    }
+}
+
+struct Test17Tag {
+    static constexpr std::string_view NAME = "Test17";
+};
+
+struct CopyOnlyTag {
+    static constexpr std::string_view NAME = "CopyOnly";
+};
+
+void Test17() {
+#ifndef VECTOR_DISABLE_STATS
+    using Stats = TaggedStats<Test17Tag>;
+    const size_t SIZE = 100;
+    {
+        static_assert(sizeof(Vector<int, std::allocator<int>, DoublingGrowth, Stats>) == sizeof(Vector<int>));
+
+        Obj::ResetCounters();
+        Vector<Obj, std::allocator<Obj>, DoublingGrowth, Stats> v(SIZE);
+        v.PushBack(Obj{1});
+        v.Reserve(SIZE * 4);
+        auto v_copy(v);
+
+        const VectorStats& stats = Stats::Get();
+        assert(stats.name == "Test17");
+        assert(stats.allocations == 4);
+        assert(stats.reallocations == 2);
+        assert(stats.bytes_allocated == (SIZE + SIZE * 2 + SIZE * 4 + SIZE + 1) * sizeof(Obj));
+        assert(stats.elements_moved == SIZE + SIZE + 1);
+        assert(stats.elements_copied == SIZE + 1);
+        assert(stats.elements_relocated == 0);
+        assert(stats.peak_capacity == SIZE * 4);
+    }
+    {
+        using CopyStats = TaggedStats<CopyOnlyTag>;
+        // При неnoexcept-перемещении реаллокация копирует элементы
+        Vector<ThrowingMoveObj, std::allocator<ThrowingMoveObj>, DoublingGrowth, CopyStats> v(SIZE);
+        v.EmplaceBack();
+        assert(CopyStats::Get().elements_copied == SIZE);
+        assert(CopyStats::Get().elements_moved == 0);
+
+        size_t entries = 0;
+        VectorStatsRegistry::Instance().ForEach([&entries](const VectorStats&) {
+            ++entries;
+        });
+        assert(entries >= 2);
+        std::ostringstream out;
+        VectorStatsRegistry::Instance().Dump(out);
+        assert(out.str().find("CopyOnly: allocations: 2, reallocations: 1") != std::string::npos);
+    }
+#endif
+}
+
+void Test18() {
+    {
+        // Буфер от порога выровнен по огромной странице, меньше порога — обычный
+        const size_t SIZE = HUGE_PAGE_SIZE / sizeof(double) * 2;
+        Vector<double, HugePageAllocator<double>> v(SIZE);
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % HUGE_PAGE_SIZE == 0);
+        v[SIZE - 1] = 1.5;
+        v.PushBack(2.5);
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % HUGE_PAGE_SIZE == 0);
+        assert(v[SIZE - 1] == 1.5 && v[SIZE] == 2.5);
+
+        v.ShrinkToFit();
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % HUGE_PAGE_SIZE == 0);
+        static_assert(sizeof(Vector<double, HugePageAllocator<double>>) == sizeof(Vector<double>));
+    }
+    {
+        Vector<Obj, HugePageAllocator<Obj, 4096>> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(v.Size() == 1000 && v[999].id == 999);
+        assert(v.Capacity() * sizeof(Obj) >= 4096);
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % HUGE_PAGE_SIZE == 0);
+    }
+}
+
+struct Record {
+    uint64_t key;
+    double value;
+};
+
+void Test19() {
+    const size_t SIZE = 10000;
+    const std::string path = (std::filesystem::temp_directory_path() / "advanced_vector_test19.bin").string();
+    std::filesystem::remove(path);
+    {
+        MappedVector<Record, 1> v(path);
+        assert(v.Size() == 0 && v.Capacity() == 0);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(Record{i, i * 0.5});
+        }
+        assert(v.Size() == SIZE && v.Capacity() >= SIZE);
+        // Аргумент ссылается на элемент, который переезжает при росте
+        const size_t capacity = v.Capacity();
+        while (v.Size() < capacity - 1) {
+            v.PushBack(Record{0, 0.0});
+        }
+        v.PushBack(v[0]);
+        v.EmplaceBack(v[1]);
+        assert(v[capacity].key == 1);
+        v.Resize(SIZE);
+        v.Sync();
+    }
+    {
+        MappedVector<Record, 1> v(path);
+        v.Prefetch();
+        assert(v.Size() == SIZE);
+        assert(v[SIZE - 1].key == SIZE - 1 && v[SIZE - 1].value == (SIZE - 1) * 0.5);
+        uint64_t sum = 0;
+        for (const Record& record : v) {
+            sum += record.key;
+        }
+        assert(sum == SIZE * (SIZE - 1) / 2);
+
+        v.Reserve(SIZE * 4);
+        assert(v.Capacity() == SIZE * 4);
+        using RecordVector = MappedVector<Record, 1>;
+        assert(std::filesystem::file_size(path) == RecordVector::HEADER_SIZE + SIZE * 4 * sizeof(Record));
+
+        MappedVector<Record, 1> moved(std::move(v));
+        assert(moved.Size() == SIZE && moved[0].key == 0);
+
+        // Перемещённый вектор пуст и годится для чтения, но без файла не растёт
+        assert(v.Size() == 0 && v.Capacity() == 0 && v.begin() == v.end());
+        v.Prefetch();
+        v.Sync();
+        v.Clear();
+        v.Resize(0);
+        bool thrown = false;
+        try {
+            v.PushBack(Record{1, 1.0});
+        } catch (const std::logic_error&) {
+            thrown = true;
+        }
+        assert(thrown && v.Size() == 0);
+        v = std::move(moved);
+        assert(v.Size() == SIZE && moved.Size() == 0);
+    }
+    {
+        // Файл с другим тегом формата не открывается
+        bool thrown = false;
+        try {
+            MappedVector<Record, 2> v(path);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    std::filesystem::remove(path);
+}
+
+void Test20() {
+    const size_t SIZE = 1000;
+    Vector<Record> v(SIZE);
+    for (size_t i = 0; i < SIZE; ++i) {
+        v[i] = Record{i, i * 0.25};
+    }
+    auto equal_to_v = [&v](const Vector<Record>& other) {
+        return other.Size() == v.Size() && std::memcmp(other.begin(), v.begin(), v.Size() * sizeof(Record)) == 0;
+    };
+    {
+        std::FILE* file = std::tmpfile();
+        const int fd = fileno(file);
+        WriteTo(fd, v);
+        lseek(fd, 0, SEEK_SET);
+        Vector<Record> read(3);
+        ReadFrom(fd, read);
+        assert(equal_to_v(read));
+
+        // Пересылка между дескрипторами без разбора элементов
+        std::FILE* forwarded = std::tmpfile();
+        lseek(fd, 0, SEEK_SET);
+        ForwardSerialized(fd, fileno(forwarded), sizeof(Record));
+        lseek(fileno(forwarded), 0, SEEK_SET);
+        ReadFrom(fileno(forwarded), read);
+        assert(equal_to_v(read));
+
+        // Чужой тип элементов отвергается, вектор остаётся пустым
+        Vector<int> wrong_type(1);
+        lseek(fd, 0, SEEK_SET);
+        bool thrown = false;
+        try {
+            ReadFrom(fd, wrong_type);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && wrong_type.Size() == 0);
+
+        std::fclose(forwarded);
+        std::fclose(file);
+    }
+    {
+        // Размеры из повреждённого потока, переполняющие size_t, отвергаются до чтения данных
+        auto rejects = [](const Vector<uint64_t>& prefixes, uint16_t flags, uint64_t size) {
+            std::FILE* file = std::tmpfile();
+            const int fd = fileno(file);
+            const SerializedVectorHeader header{SerializedVectorHeader::MAGIC, SerializedVectorHeader::VERSION,
+                                                flags, sizeof(Record), size};
+            vector_detail::WriteAll(fd, &header, sizeof(header));
+            const Record record{7, 0.5};
+            for (uint64_t prefix : prefixes) {
+                vector_detail::WriteAll(fd, &prefix, sizeof(prefix));
+                if (prefix == 1) {
+                    vector_detail::WriteAll(fd, &record, sizeof(record));
+                }
+            }
+            lseek(fd, 0, SEEK_SET);
+            Vector<Record> read(3);
+            bool thrown = false;
+            try {
+                ReadFrom(fd, read);
+            } catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            std::fclose(file);
+            return thrown && read.Size() == 0;
+        };
+        Vector<uint64_t> prefixes;
+        prefixes.PushBack(1);
+        prefixes.PushBack(UINT64_MAX);
+        assert(rejects(prefixes, SerializedVectorHeader::CHUNKED, 0));
+        prefixes[1] = UINT64_MAX / sizeof(Record);
+        assert(rejects(prefixes, SerializedVectorHeader::CHUNKED, 0));
+        assert(rejects({}, 0, UINT64_MAX / sizeof(Record) + 1));
+
+        std::FILE* file = std::tmpfile();
+        std::FILE* forwarded = std::tmpfile();
+        const SerializedVectorHeader header{SerializedVectorHeader::MAGIC, SerializedVectorHeader::VERSION, 0,
+                                            sizeof(Record), UINT64_MAX};
+        vector_detail::WriteAll(fileno(file), &header, sizeof(header));
+        lseek(fileno(file), 0, SEEK_SET);
+        bool thrown = false;
+        try {
+            ForwardSerialized(fileno(file), fileno(forwarded), sizeof(Record));
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && lseek(fileno(forwarded), 0, SEEK_END) == 0);
+        std::fclose(forwarded);
+        std::fclose(file);
+    }
+    {
+        std::FILE* file = std::tmpfile();
+        const int fd = fileno(file);
+        VectorStreamWriter<Record> writer(fd);
+        writer.Write(v.begin(), 100);
+        writer.Write(v.begin() + 100, 0);
+        writer.Write(v.begin() + 100, SIZE - 100);
+        writer.Finish();
+
+        lseek(fd, 0, SEEK_SET);
+        Vector<Record> read;
+        ReadFrom(fd, read);
+        assert(equal_to_v(read));
+
+        lseek(fd, 0, SEEK_SET);
+        VectorStreamReader<Record> reader(fd, 300);
+        Vector<Record> chunk;
+        size_t chunks = 0;
+        size_t total = 0;
+        while (reader.ReadChunk(chunk)) {
+            assert(chunk.Size() <= 300 && chunk[0].key == total);
+            total += chunk.Size();
+            ++chunks;
+        }
+        assert(total == SIZE && chunks == 4);
+        std::fclose(file);
+    }
+    {
+        // Формат WriteTo тоже читается по частям
+        std::FILE* file = std::tmpfile();
+        const int fd = fileno(file);
+        WriteTo(fd, v);
+        lseek(fd, 0, SEEK_SET);
+        VectorStreamReader<Record> reader(fd, 400);
+        Vector<Record> chunk;
+        size_t total = 0;
+        while (reader.ReadChunk(chunk)) {
+            total += chunk.Size();
+        }
+        assert(total == SIZE);
+        std::fclose(file);
+    }
+}
+
+struct ParallelObj {
+    ParallelObj() {
+        if (throw_at_construction != 0 && ++num_constructed == throw_at_construction) {
+            throw std::runtime_error("Oops");
+        }
+        ++num_alive;
+    }
+
+    ParallelObj(const ParallelObj& other)
+        : id(other.id)
+    {
+        if (other.throw_on_copy) {
+            throw std::runtime_error("Oops");
+        }
+        ++num_alive;
+    }
+
+    ParallelObj& operator=(const ParallelObj&) = default;
+
+    ~ParallelObj() {
+        --num_alive;
+    }
+
+    bool throw_on_copy = false;
+    size_t id = 0;
+
+    static inline std::atomic<int> num_alive = 0;
+    static inline std::atomic<size_t> num_constructed = 0;
+    static inline size_t throw_at_construction = 0;
+};
+
+void Test21() {
+    const size_t SIZE = vector_detail::PARALLEL_MIN_CHUNK * 8;
+    {
+        Vector<ParallelObj> v(parallel_tag, SIZE);
+        assert(v.Size() == SIZE && ParallelObj::num_alive == static_cast<int>(SIZE));
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = i;
+        }
+
+        Vector<ParallelObj> v_copy(parallel_tag, v);
+        assert(v_copy.Size() == SIZE && v_copy[SIZE - 1].id == SIZE - 1);
+        assert(ParallelObj::num_alive == static_cast<int>(SIZE * 2));
+
+        Vector<ParallelObj> small(3);
+        small.Assign(parallel_tag, v);
+        assert(small.Size() == SIZE && small[SIZE / 2].id == SIZE / 2);
+
+        small.Clear(parallel_tag);
+        v_copy.Clear(parallel_tag);
+        assert(small.Size() == 0 && ParallelObj::num_alive == static_cast<int>(SIZE));
+
+        // Исключение при копировании откатывает успешные части всех потоков
+        v[SIZE - 10].throw_on_copy = true;
+        Vector<ParallelObj> target(5);
+        try {
+            target.Assign(parallel_tag, v);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(target.Size() == 5);
+        assert(ParallelObj::num_alive == static_cast<int>(SIZE + 5));
+    }
+    assert(ParallelObj::num_alive == 0);
+    {
+        ParallelObj::throw_at_construction = SIZE / 2;
+        try {
+            Vector<ParallelObj> v(parallel_tag, SIZE);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        ParallelObj::throw_at_construction = 0;
+        assert(ParallelObj::num_alive == 0);
+    }
+    {
+        using namespace std::literals;
+        // Маленькие векторы обрабатываются в текущем потоке
+        Vector<std::string> v(parallel_tag, 10);
+        v[9] = "tail"s;
+        Vector<std::string> v_copy(parallel_tag, v);
+        assert(v_copy[9] == "tail"s);
+    }
+}
+
+template <typename T>
+void CheckSimdKernels(size_t size) {
+    Vector<T> v(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<T>((i * 7919) % 101) - static_cast<T>(50);
+    }
+    assert(Sum(v) == std::accumulate(v.begin(), v.end(), T{}));
+    assert(Count(v, T{3}) == static_cast<size_t>(std::count(v.begin(), v.end(), T{3})));
+    assert(Find(v, T{3}) == std::find(v.begin(), v.end(), T{3}));
+    assert(Find(v, T{100}) == v.end());
+    if (size > 0) {
+        const auto [min, max] = std::minmax_element(v.begin(), v.end());
+        assert(MinMax(v) == std::make_pair(*min, *max));
+        v[size - 1] = T{100};
+        assert(Find(v, T{100}) == v.begin() + (size - 1));
+    }
+
+    Vector<T> sum;
+    Transform(v, v, sum, std::plus<>{});
+    Vector<T> product = v;
+    Transform(product, v, product, std::multiplies<T>{});
+    Vector<T> custom;
+    Transform(v, v, custom, [](T lhs, T rhs) {
+        return static_cast<T>(lhs - rhs);
+    });
+    for (size_t i = 0; i < size; ++i) {
+        assert(sum[i] == static_cast<T>(v[i] + v[i]));
+        assert(product[i] == static_cast<T>(v[i] * v[i]));
+        assert(custom[i] == T{});
+    }
+
+    Fill(v, 7);
+    assert(Count(v, T{7}) == size);
+}
+
+void Test22() {
+    // Все уровни, доступные процессору, дают те же результаты, что и алгоритмы std
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::NEON, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        SetSimdLevel(level);
+        for (size_t size : {0, 1, 3, 15, 16, 17, 63, 64, 65, 1000}) {
+            CheckSimdKernels<int>(size);
+            CheckSimdKernels<float>(size);
+            CheckSimdKernels<double>(size);
+            CheckSimdKernels<int8_t>(size);
+        }
+        // Счётчики узких дорожек не переполняются
+        Vector<int8_t> bytes(100000);
+        Fill(bytes, 1);
+        assert(Count(bytes, 1) == 100000);
+    }
+    SetSimdLevel(SimdLevel::AVX512);
+    {
+        AlignedVector<float> v(1000);
+        Fill(v, 0.5f);
+        assert(Sum(v) == 500.0f);
+    }
+}
+
+struct Event {
+    size_t producer = 0;
+    size_t sequence = 0;
+};
+
+// Конструктор бросает для отрицательных значений
+struct CheckedValue {
+    explicit CheckedValue(int value)
+        : value(value)
+    {
+        if (value < 0) {
+            throw std::invalid_argument("negative value");
+        }
+    }
+
+    int value;
+};
+
+void Test23() {
+    const size_t PRODUCERS = 4;
+    const size_t PER_PRODUCER = 10000;
+    {
+        ConcurrentVector<Event> events;
+        const Event* first = &events.EmplaceBack(Event{PRODUCERS, 0});
+
+        std::atomic<bool> done = false;
+        // Читатель обходит опубликованный префикс, пока производители пишут
+        std::thread reader([&events, &done] {
+            size_t checked = 0;
+            while (!done.load()) {
+                const size_t published = events.PublishedSize();
+                for (; checked < published; ++checked) {
+                    assert(events[checked].producer <= PRODUCERS);
+                }
+            }
+        });
+        Vector<std::thread> producers;
+        for (size_t producer = 0; producer < PRODUCERS; ++producer) {
+            producers.EmplaceBack([&events, producer] {
+                for (size_t i = 0; i < PER_PRODUCER; ++i) {
+                    events.PushBack(Event{producer, i});
+                }
+            });
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+        done = true;
+        reader.join();
+
+        const size_t total = PRODUCERS * PER_PRODUCER + 1;
+        assert(events.Size() == total && events.PublishedSize() == total);
+        assert(&events[0] == first);
+
+        Vector<Event> frozen = events.Freeze();
+        assert(frozen.Size() == total && events.Size() == 0);
+        // Порядок между потоками произвольный, внутри потока сохраняется
+        Vector<size_t> next(PRODUCERS + 1);
+        for (const Event& event : frozen) {
+            assert(event.sequence == next[event.producer]++);
+        }
+        for (size_t producer = 0; producer < PRODUCERS; ++producer) {
+            assert(next[producer] == PER_PRODUCER);
+        }
+    }
+    {
+        // Много производителей на коротких векторах: граница публикации не должна застревать,
+        // даже когда два потока публикуют соседние индексы одновременно
+        const size_t CONTENDED_PRODUCERS = 16;
+        for (int round = 0; round < 50; ++round) {
+            ConcurrentVector<size_t> values;
+            Vector<std::thread> producers;
+            for (size_t producer = 0; producer < CONTENDED_PRODUCERS; ++producer) {
+                producers.EmplaceBack([&values, producer] {
+                    for (size_t i = 0; i < 100; ++i) {
+                        values.PushBack(producer);
+                    }
+                });
+            }
+            for (std::thread& producer : producers) {
+                producer.join();
+            }
+            assert(values.Size() == CONTENDED_PRODUCERS * 100 && values.PublishedSize() == values.Size());
+            assert(values.Freeze().Size() == CONTENDED_PRODUCERS * 100);
+        }
+    }
+    {
+        // Бросающий конструктор не оставляет дыр: граница публикации доходит до конца
+        const size_t THROWING_PRODUCERS = 8;
+        ConcurrentVector<CheckedValue> values;
+        Vector<std::thread> producers;
+        for (size_t producer = 0; producer < THROWING_PRODUCERS; ++producer) {
+            producers.EmplaceBack([&values] {
+                for (int i = 0; i < 300; ++i) {
+                    try {
+                        values.EmplaceBack(i % 3 == 0 ? -1 : i);
+                        assert(i % 3 != 0);
+                    } catch (const std::invalid_argument&) {
+                    }
+                }
+            });
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+        const size_t expected = THROWING_PRODUCERS * 200;
+        assert(values.Size() == expected && values.PublishedSize() == expected);
+        Vector<CheckedValue> frozen = values.Freeze();
+        assert(frozen.Size() == expected);
+        assert(std::all_of(frozen.begin(), frozen.end(), [](const CheckedValue& checked) {
+            return checked.value % 3 != 0;
+        }));
+    }
+    {
+        Obj::ResetCounters();
+        {
+            ConcurrentVector<Obj> v;
+            for (int i = 0; i < 100; ++i) {
+                v.EmplaceBack(i);
+            }
+            assert(v[99].id == 99);
+            Vector<Obj> frozen = v.Freeze();
+            assert(frozen.Size() == 100 && frozen[42].id == 42);
+            v.EmplaceBack(1);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test24() {
+    const size_t SIZE = 1000;
+    Obj::ResetCounters();
+    {
+        StableVector<Obj, 64> v;
+        const Obj* first = &v.EmplaceBack(0);
+        auto first_it = v.begin();
+        for (int i = 1; i < static_cast<int>(SIZE); ++i) {
+            v.EmplaceBack(i);
+        }
+        // Рост не перемещает элементы, указатели и итераторы действительны
+        assert(Obj::num_moved == 0 && Obj::num_copied == 0);
+        assert(&v[0] == first && &*first_it == first);
+        assert(v.Size() == SIZE && v.Capacity() == 1024);
+        assert(v.end() - v.begin() == static_cast<ptrdiff_t>(SIZE));
+        assert(v.begin()[500].id == 500 && (v.end() - 1)->id == static_cast<int>(SIZE - 1));
+
+        // Аргумент может ссылаться на элемент самого вектора
+        v.Resize(1024);
+        v.PushBack(v[10]);
+        assert(v[1024].id == 10);
+
+        StableVector<Obj, 64> v_copy(v);
+        assert(v_copy.Size() == SIZE + 25 && v_copy[999].id == 999);
+        v_copy.PopBack();
+        v_copy.ShrinkToFit();
+        assert(v_copy.Capacity() == 1024);
+
+        StableVector<Obj, 64> moved(std::move(v));
+        assert(moved.Size() == SIZE + 25 && &moved[0] == first);
+        v = moved;
+        assert(v.Size() == SIZE + 25);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        StableVector<int, 16> v;
+        for (int i = 100; i > 0; --i) {
+            v.PushBack(i);
+        }
+        std::sort(v.begin(), v.end());
+        assert(std::is_sorted(v.cbegin(), v.cend()) && v[0] == 1 && v[99] == 100);
+        StableVector<int, 16>::const_iterator it = v.begin();
+        assert(it == v.cbegin() && *(it + 3) == 4);
+    }
+    {
+        // Исключение в конструкторе элемента не оставляет утечек
+        Obj::ResetCounters();
+        Obj::default_construction_throw_countdown = 100;
+        try {
+            StableVector<Obj, 16> v(SIZE);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test25() {
+    const size_t SIZE = 1000;
+    Obj::ResetCounters();
+    {
+        GapVector<Obj> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Reserve(SIZE * 2);
+        const int moved_before = Obj::num_moved;
+        // Первая правка сдвигает зазор к курсору, последующие рядом с ним почти бесплатны
+        v.Emplace(SIZE / 2, -1);
+        const int moved_by_first = Obj::num_moved - moved_before;
+        assert(moved_by_first <= static_cast<int>(SIZE / 2) + 1);
+        for (int i = 0; i < 100; ++i) {
+            v.Emplace(SIZE / 2 + 1 + i, -2);
+        }
+        assert(Obj::num_moved - moved_before == moved_by_first);
+        assert(v.GapPosition() == SIZE / 2 + 101);
+        v.Erase(SIZE / 2 + 100);
+        v.Erase(SIZE / 2 + 99);
+        assert(v.Size() == SIZE + 99);
+        assert(v[SIZE / 2 - 1].id == static_cast<int>(SIZE / 2 - 1) && v[SIZE / 2].id == -1);
+        assert(v[SIZE / 2 + 1].id == -2 && v[SIZE / 2 + 99].id == static_cast<int>(SIZE / 2));
+
+        // Аргумент может ссылаться на элемент, который сдвинет зазор
+        v.Insert(0, v[SIZE]);
+        assert(v[0].id == v[SIZE + 1].id);
+
+        GapVector<Obj> v_copy(v);
+        const Obj* data = v_copy.Compact();
+        assert(v_copy.GapPosition() == v_copy.Size());
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(data[i].id == v[i].id);
+        }
+        v_copy.PopBack();
+        v = std::move(v_copy);
+        assert(v.Size() == SIZE + 99);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        GapVector<int> v;
+        for (int i = 0; i < 10; ++i) {
+            v.Insert(0, i);
+        }
+        v.Erase(9);
+        v.Insert(5, 42);
+        const int* data = v.Compact();
+        const int expected[] = {9, 8, 7, 6, 5, 42, 4, 3, 2, 1};
+        assert(std::equal(data, data + v.Size(), std::begin(expected), std::end(expected)));
+        v.Clear();
+        assert(v.Size() == 0 && v.Capacity() == 16);
+    }
+}
+
+void Test26() {
+    const size_t SIZE = 1000;
+    {
+        SoaVector<float, float, int> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.EmplaceBack(static_cast<float>(i), static_cast<float>(i) * 2, i);
+        }
+        v.PushBack({-1.0f, -2.0f, -1});
+        assert(v.Size() == SIZE + 1 && v.Capacity() >= v.Size());
+
+        // Столбец — непрерывный массив
+        const float* xs = v.Column<0>();
+        assert(std::accumulate(xs, xs + SIZE, 0.0) == SIZE * (SIZE - 1) / 2.0);
+        assert(v.Get<2>(SIZE) == -1);
+
+        for (auto [x, y, id] : v) {
+            y = x + static_cast<float>(id);
+        }
+        assert(v.Get<1>(10) == 20.0f);
+        const auto [x, y, id] = std::as_const(v)[SIZE];
+        assert(x == -1.0f && y == -2.0f && id == -1);
+        assert(std::distance(v.begin(), v.end()) == static_cast<std::ptrdiff_t>(v.Size()));
+
+        // Полный набор операций итератора произвольного доступа
+        const auto first = v.cbegin();
+        const auto middle = 10 + first;
+        assert(middle == first + 10 && middle - first == 10);
+        assert(middle > first && first < middle && first <= first && middle >= first);
+        assert(!(first > middle) && !(middle <= first) && !(first >= middle));
+        const auto found = std::lower_bound(first, v.cend() - 1, 500, [](const auto& row, int value) {
+            return std::get<2>(row) < value;
+        });
+        assert(found - first == 500 && std::get<2>(*found) == 500);
+
+        SoaVector<float, float, int> v_copy(v);
+        v.PopBack();
+        v.Swap(v_copy);
+        assert(v.Size() == SIZE + 1 && v_copy.Size() == SIZE);
+        v = std::move(v_copy);
+        assert(v.Size() == SIZE);
+        v.Clear();
+        assert(v.Size() == 0 && v.Capacity() >= SIZE);
+    }
+    Obj::ResetCounters();
+    {
+        SoaVector<Obj, std::string, Obj> v;
+        v.Reserve(2);
+        v.EmplaceBack(1, "a", 1);
+        Obj throwing(2);
+        throwing.throw_on_copy = true;
+        // Поле третьего столбца бросит исключение: две созданные части строки откатываются,
+        // и при свободной ёмкости, и при росте
+        for (int i = 0; i < 2; ++i) {
+            const int alive = Obj::GetAliveObjectCount();
+            try {
+                v.EmplaceBack(3, "b", throwing);
+                assert(false);
+            } catch (const std::runtime_error&) {
+            }
+            assert(Obj::GetAliveObjectCount() == alive);
+            assert(v.Size() == static_cast<size_t>(i + 1));
+            v.EmplaceBack(4, "c", 4);
+        }
+        assert(v.Capacity() == 4);
+        assert(v.Get<0>(0).id == 1 && v.Get<1>(1) == "c" && v.Get<2>(2).id == 4);
+
+        // Аргумент может ссылаться на элемент вектора при росте
+        v.EmplaceBack(5, v.Get<1>(0), v.Get<2>(0));
+        v.EmplaceBack(6, v.Get<1>(0), v.Get<2>(0));
+        assert(v.Capacity() == 8 && v.Get<1>(4) == "a" && v.Get<2>(4).id == 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test27() {
+    const size_t SIZE = 1000;
+    Obj::ResetCounters();
+    {
+        Vector<Obj> source;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            source.EmplaceBack(i);
+        }
+        CowVector<Obj> v(std::move(source));
+        const int copied_before = Obj::num_copied;
+
+        // Снимки разделяют буфер и ничего не копируют
+        CowVector<Obj> snapshot = v;
+        const CowVector<Obj>& reader = snapshot;
+        assert(Obj::num_copied == copied_before);
+        assert(v.UseCount() == 2 && snapshot.IsShared());
+        assert(&reader[0] == &std::as_const(v)[0] && reader.Size() == SIZE);
+
+        // Первая запись отделяет буфер, снимок остаётся прежним
+        v[0].id = -1;
+        assert(Obj::num_copied == copied_before + static_cast<int>(SIZE));
+        assert(!v.IsShared() && !snapshot.IsShared());
+        assert(reader[0].id == 0 && std::as_const(v)[0].id == -1);
+        v[1].id = -2;
+        assert(Obj::num_copied == copied_before + static_cast<int>(SIZE));
+
+        // Аргумент может ссылаться на разделяемый элемент, даже если снимок исчезнет
+        CowVector<Obj> other = v;
+        v = snapshot;
+        snapshot = CowVector<Obj>();
+        assert(v.UseCount() == 1 && other.UseCount() == 1);
+        other.PushBack(std::as_const(other)[0]);
+        assert(other.Size() == SIZE + 1 && std::as_const(other)[SIZE].id == -1);
+
+        CowVector<Obj> erased = other;
+        erased.Erase(erased.cbegin() + 1, erased.cbegin() + 3);
+        erased.Insert(erased.cbegin(), Obj(42));
+        assert(erased.Size() == SIZE && std::as_const(erased)[0].id == 42 && std::as_const(erased)[1].id == -1);
+        assert(std::as_const(erased)[2].id == 3 && std::as_const(other)[1].id == -2);
+
+        // Clear разделяемого буфера его не копирует
+        const int alive = Obj::GetAliveObjectCount();
+        CowVector<Obj> cleared = other;
+        cleared.Clear();
+        assert(cleared.Size() == 0 && cleared.UseCount() == 0 && Obj::GetAliveObjectCount() == alive);
+
+        CowVector<Obj> reserved = other;
+        reserved.Reserve(SIZE * 4);
+        assert(reserved.Capacity() == SIZE * 4 && reserved.Size() == SIZE + 1 && !other.IsShared());
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Снимки передаются читающим потокам, пока писатель изменяет свою копию
+        CowVector<int> v{Vector<int>(SIZE)};
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i) {
+            readers.emplace_back([snapshot = v] {
+                assert(std::accumulate(snapshot.begin(), snapshot.end(), 0) == 0);
+            });
+        }
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        assert(v.Size() == SIZE + 100 && v.UseCount() == 1);
+    }
+}
+
+namespace {
+
+// Блоки по BLOCK элементов: allocate_at_least округляет ёмкость до 8, expand растит блок до BLOCK
+template <typename T>
+struct SlackAllocator {
+    static constexpr size_t BLOCK = 256;
+
+    using value_type = T;
+
+    struct allocation_result {
+        T* ptr;
+        size_t count;
+    };
+
+    SlackAllocator() noexcept = default;
+
+    template <typename U>
+    SlackAllocator(const SlackAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        ++num_allocations;
+        return std::allocator<T>{}.allocate(std::max(n, BLOCK));
+    }
+
+    allocation_result allocate_at_least(size_t n) {
+        const size_t count = (n + 7) / 8 * 8;
+        return {allocate(count), count};
+    }
+
+    size_t expand(T* /*p*/, size_t n, size_t new_n) noexcept {
+        ++num_expansions;
+        return new_n <= BLOCK ? new_n : n;
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        std::allocator<T>{}.deallocate(p, std::max(n, BLOCK));
+    }
+
+    bool operator==(const SlackAllocator&) const noexcept {
+        return true;
+    }
+    bool operator!=(const SlackAllocator&) const noexcept {
+        return false;
+    }
+
+    static inline int num_allocations = 0;
+    static inline int num_expansions = 0;
+};
+
+}  // namespace
+
+void Test28() {
+    {
+        Vector<int, UsableSizeAllocator<int>> v;
+        v.Reserve(5);
+        assert(v.Capacity() >= 5);
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Size() == 1000 && v.Capacity() >= 1000 && v[999] == 999);
+    }
+    {
+        Vector<int, SlackAllocator<int>> v;
+        v.Reserve(100);
+        assert(v.Capacity() == 104 && SlackAllocator<int>::num_allocations == 1);
+
+        // Рост в пределах BLOCK идёт на месте, дальше — переносом в новый блок
+        const int* data = v.begin();
+        for (int i = 0; i < 200; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.begin() == data && SlackAllocator<int>::num_allocations == 1 && v.Capacity() == 208);
+        v.Insert(v.begin() + 1, 9, -1);
+        assert(SlackAllocator<int>::num_allocations == 2 && v.Capacity() == 400);
+        assert(v[0] == 0 && v[1] == -1 && v[9] == -1 && v[10] == 1 && v.Size() == 209);
+    }
+    {
+        // Нетривиальные элементы при росте на месте не перемещаются
+        Vector<std::string, SlackAllocator<std::string>> v;
+        v.PushBack("first");
+        assert(v.Capacity() == 8);
+        const std::string* first = &v[0];
+        v.Insert(v.begin(), 20, "x");
+        assert(&v[0] == first && v.Capacity() == 21 && v[20] == "first");
+        v.EmplaceBack(v[20]);
+        assert(&v[0] == first && v.Size() == 22 && v[21] == "first");
+    }
+}
+
+namespace {
+
+struct PacketField {
+    int offset = 0;
+    int length = 0;
+};
+
+constexpr StaticVector<PacketField, 8> MakeHeaderLayout() {
+    StaticVector<PacketField, 8> fields;
+    int offset = 0;
+    for (int length : {4, 4, 8, 2}) {
+        fields.PushBack({offset, length});
+        offset += length;
+    }
+    fields.Erase(fields.begin() + 1);
+    fields.Insert(fields.begin(), {-1, 0});
+    fields.Emplace(fields.end(), PacketField{offset, 0});
+    StaticVector<PacketField, 8> copy = fields;
+    copy.PopBack();
+    return copy;
+}
+
+}  // namespace
+
+void Test29() {
+    {
+        // Таблица строится на этапе компиляции
+        constexpr StaticVector<PacketField, 8> LAYOUT = MakeHeaderLayout();
+        static_assert(LAYOUT.Size() == 4 && LAYOUT.Capacity() == 8);
+        static_assert(LAYOUT[0].offset == -1 && LAYOUT[1].offset == 0 && LAYOUT[2].offset == 8);
+        static_assert(LAYOUT[3].length == 2);
+        constexpr StaticVector<int, 4> VALUES = {1, 2, 3};
+        static_assert(VALUES.Size() == 3 && VALUES[2] == 3);
+
+        static_assert(std::is_trivially_destructible_v<StaticVector<int, 4>>);
+        static_assert(std::is_trivially_destructible_v<StaticVector<std::pair<int, int>, 4>>);
+        static_assert(!std::is_trivially_destructible_v<StaticVector<std::string, 4>>);
+
+        // Те же операции во время выполнения идут через EmplaceShifted/EraseShifted
+        StaticVector<int, 8> v = {1, 2, 3, 4};
+        v.Insert(v.begin() + 1, v[3]);
+        v.Erase(v.begin() + 3, v.begin() + 5);
+        const int expected[] = {1, 4, 2};
+        assert(std::equal(v.begin(), v.end(), std::begin(expected), std::end(expected)));
+        v.Resize(8);
+        assert(v.Full() && v[7] == 0 && v.TryEmplaceBack(9) == nullptr);
+    }
+    Obj::ResetCounters();
+    {
+        StaticVector<Obj, 16> v(4);
+        for (int i = 0; i < 8; ++i) {
+            v.EmplaceBack(i);
+        }
+        // Аргумент может ссылаться на сдвигаемый элемент
+        v.Emplace(v.begin(), v[v.Size() - 1]);
+        assert(v.Size() == 13 && v[0].id == 7 && v[5].id == 0);
+        v.Erase(v.begin() + 1, v.begin() + 5);
+        assert(v.Size() == 9 && v[1].id == 0 && v[8].id == 7);
+
+        StaticVector<Obj, 16> v_copy(v);
+        v_copy.PopBack();
+        v = v_copy;
+        assert(v.Size() == 8 && v[7].id == 6);
+        v_copy.Clear();
+        v_copy = std::move(v);
+        assert(v_copy.Size() == 8);
+
+        v[3].throw_on_copy = true;
+        try {
+            StaticVector<Obj, 16> broken(v);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(Obj::GetAliveObjectCount() == 16);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+// Считает буферы, прошедшие через политику освобождения
+struct CountingReclaim {
+    template <typename T, typename Alloc>
+    static void Retire(RawMemory<T, Alloc> buffer, size_t size) noexcept {
+        if (buffer.Capacity() != 0) {
+            ++num_retired;
+            num_retired_alive += static_cast<int>(size);
+        }
+        ImmediateReclaim::Retire(std::move(buffer), size);
+    }
+
+    static inline int num_retired = 0;
+    static inline int num_retired_alive = 0;
+};
+
+void Test30() {
+    const size_t SIZE = 1000;
+    {
+        // Старые буферы роста при вставке и переноса между неравными аллокаторами
+        // тоже проходят через политику, вместе с перемещёнными элементами
+        Vector<std::string, std::allocator<std::string>, DoublingGrowth, NoStats, CountingReclaim> v(4);
+        CountingReclaim::num_retired = 0;
+        CountingReclaim::num_retired_alive = 0;
+        v.PushBack("a");
+        assert(CountingReclaim::num_retired == 1 && CountingReclaim::num_retired_alive == 4);
+        v.Emplace(v.cbegin(), "b");
+        v.Insert(v.cbegin() + 1, 10, std::string("c"));
+        assert(CountingReclaim::num_retired == 2 && CountingReclaim::num_retired_alive == 10);
+        v.Insert(v.cbegin() + 1, 10, std::string("d"));
+        assert(CountingReclaim::num_retired == 3 && CountingReclaim::num_retired_alive == 26);
+        assert(v.Size() == 26 && v[0] == "b" && v[1] == "d" && v[11] == "c" && v[21].empty() && v[25] == "a");
+
+        using Alloc = TrackingAllocator<int, false>;
+        using TrackedVector = Vector<int, Alloc, DoublingGrowth, NoStats, CountingReclaim>;
+        TrackedVector source(10, Alloc(1));
+        TrackedVector target(20, Alloc(2));
+        target = std::move(source);
+        assert(CountingReclaim::num_retired == 4 && CountingReclaim::num_retired_alive == 46);
+
+        using PropagatingAlloc = TrackingAllocator<int, true>;
+        using PropagatingVector = Vector<int, PropagatingAlloc, DoublingGrowth, NoStats, CountingReclaim>;
+        const PropagatingVector copy_source(5, PropagatingAlloc(1));
+        PropagatingVector copy_target(8, PropagatingAlloc(2));
+        copy_target = copy_source;
+        assert(CountingReclaim::num_retired == 5 && CountingReclaim::num_retired_alive == 54);
+        assert(copy_target.Size() == 5 && copy_target.GetAllocator() == copy_source.GetAllocator());
+    }
+    Obj::ResetCounters();
+    {
+        using DeferredVector = Vector<Obj, std::allocator<Obj>, DoublingGrowth, NoStats, DeferredReclaim<0>>;
+        {
+            DeferredVector v(SIZE);
+            DeferredVector other(SIZE / 2);
+            // Старые буферы присваивания и ShrinkToFit тоже откладываются
+            other = std::move(v);
+            other.PopBack();
+            other.ShrinkToFit();
+        }
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE / 2 + 2 * (SIZE - 1)));
+        assert(DeferredPendingBytes() == (SIZE / 2 + SIZE + SIZE - 1) * sizeof(Obj));
+        ReclaimDeferred();
+        assert(Obj::GetAliveObjectCount() == 0 && DeferredPendingBytes() == 0);
+
+        // Превышение лимита освобождает пакет сразу
+        using LimitedVector = Vector<Obj, std::allocator<Obj>, DoublingGrowth, NoStats, DeferredReclaim<0, SIZE * sizeof(Obj)>>;
+        {
+            LimitedVector small(SIZE / 2);
+        }
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE / 2));
+        {
+            LimitedVector large(SIZE);
+        }
+        assert(Obj::GetAliveObjectCount() == 0 && DeferredPendingBytes() == 0);
+
+        // Маленькие буферы освобождаются сразу
+        {
+            Vector<Obj, std::allocator<Obj>, DoublingGrowth, NoStats, DeferredReclaim<SIZE * sizeof(Obj)>> v(10);
+        }
+        assert(Obj::GetAliveObjectCount() == 0 && DeferredPendingBytes() == 0);
+    }
+    {
+        // Вложенные векторы откладываются повторно и освобождаются тем же вызовом
+        using Inner = Vector<std::string, std::allocator<std::string>, DoublingGrowth, NoStats, DeferredReclaim<0>>;
+        {
+            Vector<Inner, std::allocator<Inner>, DoublingGrowth, NoStats, DeferredReclaim<0>> v(10);
+            for (auto& inner : v) {
+                inner.Resize(10);
+            }
+        }
+        assert(DeferredPendingBytes() > 0);
+        ReclaimDeferred();
+        assert(DeferredPendingBytes() == 0);
+    }
+    {
+        BackgroundReclaimer* reclaimer = BackgroundReclaimer::Instance();
+        assert(reclaimer != nullptr);
+        {
+            Vector<Obj, std::allocator<Obj>, DoublingGrowth, NoStats, BackgroundReclaim<0>> v(SIZE);
+            v.Reserve(SIZE * 2);
+        }
+        reclaimer->Drain();
+        assert(Obj::GetAliveObjectCount() == 0 && reclaimer->PendingBytes() == 0);
+
+        // При переполнении очереди буфер освобождает вызывающий поток
+        {
+            Vector<Obj, std::allocator<Obj>, DoublingGrowth, NoStats, BackgroundReclaim<0, 1>> v(SIZE);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test31() {
+    using PooledInts = Vector<int, PoolAllocator<int>>;
+    {
+        // Ёмкость — весь класс размера
+        PooledInts v;
+        v.PushBack(1);
+        assert(v.Capacity() == POOL_MIN_BLOCK / sizeof(int));
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Capacity() == 128 && v[100] == 99);
+    }
+    {
+        // Второй вектор растёт по тем же классам и берёт блоки, освобождённые первым
+        const PoolStats before = GetThreadPoolStats();
+        for (int round = 0; round < 2; ++round) {
+            PooledInts v;
+            for (int i = 0; i < 1000; ++i) {
+                v.PushBack(i);
+            }
+        }
+        const PoolStats after = GetThreadPoolStats();
+        const size_t grows = after.allocations - before.allocations;
+        assert(grows % 2 == 0);
+        assert(after.system_allocations - before.system_allocations <= grows / 2);
+        assert(after.reused - before.reused >= grows / 2);
+        assert(after.local_frees - before.local_frees == grows);
+    }
+    {
+        // Блок, освобождённый в другом потоке, возвращается владельцу через очередь
+        PooledInts v;
+        v.Reserve(2000);
+        const int* block = v.begin();
+        const PoolStats before = GetThreadPoolStats();
+        std::thread([moved = std::move(v)]() mutable {
+            PooledInts released = std::move(moved);
+        }).join();
+        assert(GetThreadPoolStats().remote_frees == before.remote_frees + 1);
+        PooledInts reused;
+        reused.Reserve(2000);
+        assert(reused.begin() == block && GetThreadPoolStats().system_allocations == before.system_allocations);
+    }
+    {
+        using Inner = Vector<int, PoolAllocator<int>>;
+        Vector<Inner, PoolAllocator<Inner>> v(1000);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            for (size_t j = 0; j < i % 7; ++j) {
+                v[i].PushBack(static_cast<int>(j));
+            }
+        }
+        assert(v[6].Size() == 6 && v[6].Capacity() == 8);
+
+        // Большие блоки идут мимо пула
+        const size_t large_before = GetThreadPoolStats().large_allocations;
+        PooledInts large;
+        large.Reserve(POOL_MAX_BLOCK);
+        assert(large.Capacity() == POOL_MAX_BLOCK && GetThreadPoolStats().large_allocations == large_before + 1);
+    }
+    // Потоки с собственными пулами и перекрёстным освобождением
+    std::vector<PooledInts> results(4);
+    std::vector<std::thread> threads;
+    for (auto& result : results) {
+        threads.emplace_back([&result] {
+            for (int i = 0; i < 10000; ++i) {
+                result.PushBack(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    results.clear();
+    assert(GetThreadPoolStats().cached_bytes <= POOL_MAX_CACHED_BYTES);
+}
+
+// Перемещение может бросать, поэтому слияние копирует. Счётчик атомарный: части сортируются в разных потоках
+struct ThrowingMoveKey {
+    ThrowingMoveKey(int key, int seq)
+        : key(key)
+        , seq(seq)  //
+    {
+        ++alive;
+    }
+
+    ThrowingMoveKey(const ThrowingMoveKey& other)
+        : key(other.key)
+        , seq(other.seq)  //
+    {
+        ++alive;
+    }
+
+    ThrowingMoveKey(ThrowingMoveKey&& other) noexcept(false)
+        : key(other.key)
+        , seq(other.seq)  //
+    {
+        ++alive;
+    }
+
+    ThrowingMoveKey& operator=(const ThrowingMoveKey&) = default;
+    ThrowingMoveKey& operator=(ThrowingMoveKey&&) noexcept(false) = default;
+
+    ~ThrowingMoveKey() {
+        --alive;
+    }
+
+    int key;
+    int seq;
+    static inline std::atomic<int> alive = 0;
+};
+
+void Test32() {
+    // Части задаются явно, чтобы слияние проверялось и на одноядерной машине
+    const size_t CHUNKS = 5;
+    const int SIZE = 10000;
+    {
+        Vector<int> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack((i * 7919) % SIZE);
+        }
+        RawMemory<int> scratch;
+        vector_detail::ParallelMergeSort<false>(v.begin(), v.Size(), std::less<>{}, scratch, CHUNKS);
+        for (int i = 0; i < SIZE; ++i) {
+            assert(v[i] == i);
+        }
+        // Буфер переиспользуется без нового выделения
+        int* const buffer = scratch.GetAddress();
+        assert(scratch.Capacity() >= static_cast<size_t>(SIZE));
+        vector_detail::ParallelMergeSort<true>(v.begin(), v.Size(), std::greater<>{}, scratch, CHUNKS);
+        assert(scratch.GetAddress() == buffer && v[0] == SIZE - 1 && v[SIZE - 1] == 0);
+
+        ParallelSort(v);
+        assert(std::is_sorted(v.begin(), v.end()));
+    }
+    {
+        Vector<std::string> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(std::to_string((i * 37) % 1000));
+        }
+        RawMemory<std::string> scratch;
+        vector_detail::ParallelMergeSort<false>(v.begin(), v.Size(), std::less<>{}, scratch, CHUNKS);
+        assert(std::is_sorted(v.begin(), v.end()) && v[0] == "0" && v[999] == "999");
+
+        // Бросающий компаратор не передаётся в std::sort: после исключения набор элементов тот же
+        static_assert(vector_detail::std_sort_safe_v<std::string, std::less<>>);
+        std::vector<std::string> expected(v.begin(), v.end());
+        for (size_t chunks : {size_t{1}, CHUNKS}) {
+            // Исключение бросается ближе к концу, когда std::sort уже досортировывает вставками
+            std::reverse(v.begin(), v.end());
+            std::atomic<int> comparisons = 0;
+            std::atomic<int> throw_at = 0;
+            const auto throwing = [&comparisons, &throw_at](const std::string& lhs, const std::string& rhs) {
+                if (++comparisons == throw_at) {
+                    throw std::runtime_error("Oops");
+                }
+                return lhs < rhs;
+            };
+            Vector<std::string> probe(v);
+            vector_detail::ParallelMergeSort<false>(probe.begin(), probe.Size(), throwing, scratch, chunks);
+            throw_at = comparisons - 20;
+            comparisons = 0;
+            static_assert(!vector_detail::std_sort_safe_v<std::string, decltype(throwing)>);
+            try {
+                vector_detail::ParallelMergeSort<false>(v.begin(), v.Size(), throwing, scratch, chunks);
+                assert(false);
+            } catch (const std::runtime_error&) {
+            }
+            std::vector<std::string> remaining(v.begin(), v.end());
+            std::sort(remaining.begin(), remaining.end());
+            assert(remaining == expected);
+            vector_detail::ParallelMergeSort<false>(v.begin(), v.Size(), std::less<>{}, scratch, chunks);
+            assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+        }
+    }
+    {
+        // Устойчивость: равные ключи сохраняют исходный порядок
+        Vector<ThrowingMoveKey> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceBack((i * 31) % 17, i);
+        }
+        const auto by_key = [](const ThrowingMoveKey& lhs, const ThrowingMoveKey& rhs) {
+            return lhs.key < rhs.key;
+        };
+        RawMemory<ThrowingMoveKey> scratch;
+        vector_detail::ParallelMergeSort<true>(v.begin(), v.Size(), by_key, scratch, CHUNKS);
+        for (int i = 1; i < SIZE; ++i) {
+            assert(v[i - 1].key < v[i].key || (v[i - 1].key == v[i].key && v[i - 1].seq < v[i].seq));
+        }
+        assert(ThrowingMoveKey::alive == SIZE);
+        ParallelStableSort(v, [](const ThrowingMoveKey& lhs, const ThrowingMoveKey& rhs) {
+            return lhs.seq < rhs.seq;
+        });
+        assert(v[0].seq == 0 && v[SIZE - 1].seq == SIZE - 1);
+
+        // Исключение из компаратора: ни один элемент не потерян и не продублирован
+        std::atomic<int> comparisons = 0;
+        const auto throwing = [&comparisons](const ThrowingMoveKey& lhs, const ThrowingMoveKey& rhs) {
+            if (++comparisons == 50000) {
+                throw std::runtime_error("Oops");
+            }
+            return lhs.key > rhs.key;
+        };
+        try {
+            vector_detail::ParallelMergeSort<true>(v.begin(), v.Size(), throwing, scratch, CHUNKS);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(ThrowingMoveKey::alive == SIZE && v.Size() == static_cast<size_t>(SIZE));
+        std::vector<bool> seen(SIZE);
+        for (const ThrowingMoveKey& value : v) {
+            assert(!seen[value.seq]);
+            seen[value.seq] = true;
+        }
+
+        // Неустойчивая сортировка копирует такие элементы и тоже ничего не теряет
+        comparisons = 0;
+        try {
+            vector_detail::ParallelMergeSort<false>(v.begin(), v.Size(), throwing, scratch, 1);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(ThrowingMoveKey::alive == SIZE);
+        seen.assign(SIZE, false);
+        for (const ThrowingMoveKey& value : v) {
+            assert(!seen[value.seq]);
+            seen[value.seq] = true;
+        }
+        ParallelSort(v, by_key);
+        assert(std::is_sorted(v.begin(), v.end(), by_key));
+    }
+    assert(ThrowingMoveKey::alive == 0);
+    {
+        Vector<int> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i);
+        }
+        const auto is_even = [](int value) {
+            return value % 2 == 0;
+        };
+        int* split = vector_detail::ParallelPartitionChunks(v.begin(), v.Size(), is_even, CHUNKS);
+        assert(split == v.begin() + SIZE / 2);
+        assert(std::all_of(v.begin(), split, is_even) && std::none_of(split, v.end(), is_even));
+        long long sum = 0;
+        for (int value : v) {
+            sum += value;
+        }
+        assert(sum == static_cast<long long>(SIZE) * (SIZE - 1) / 2);
+        assert(ParallelPartition(v, is_even) == v.begin() + SIZE / 2);
+    }
+}
+
+// Номер узла, на котором лежит страница с addr; -1, если узнать нельзя
+int NodeOfPage(const void* addr) {
+    int node = -1;
+    const unsigned long MPOL_F_NODE_ADDR = 3;  // MPOL_F_NODE | MPOL_F_ADDR
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, addr, MPOL_F_NODE_ADDR) != 0) {
+        return -1;
+    }
+    return node;
+}
+
+// Конструктор бросает на заданном по счёту объекте; счётчики атомарные, части строятся в разных потоках
+struct CountdownThrower {
+    CountdownThrower() {
+        if (--countdown == 0) {
+            throw std::runtime_error("Oops");
+        }
+        ++alive;
+    }
+
+    CountdownThrower(const CountdownThrower&) {
+        ++alive;
+    }
+
+    ~CountdownThrower() {
+        --alive;
+    }
+
+    double value = 0;
+    static inline std::atomic<int> countdown = 0;
+    static inline std::atomic<int> alive = 0;
+};
+
+void Test33() {
+    const NumaTopology& topology = NumaTopology::Instance();
+    assert(topology.NodeCount() >= 1 && topology.CpuCount(0) >= 1);
+    assert(topology.AllNodes() >> topology.NodeId(0) & 1);
+
+    const size_t SIZE = size_t{1} << 20;
+    cpu_set_t before;
+    assert(sched_getaffinity(0, sizeof(before), &before) == 0);
+    {
+        // Первое касание потоками узлов; привязка вызывающего потока восстанавливается
+        using NumaDoubles = Vector<double, NumaAllocator<double>>;
+        NumaDoubles v(parallel_tag, SIZE, NumaAllocator<double>(NumaPolicy::Local()));
+        assert(std::all_of(v.begin(), v.end(), [](double value) {
+            return value == 0.0;
+        }));
+        cpu_set_t after;
+        assert(sched_getaffinity(0, sizeof(after), &after) == 0 && CPU_EQUAL(&before, &after));
+        size_t covered = 0;
+        for (size_t node = 0; node < topology.NodeCount(); ++node) {
+            const auto [first, last] = NumaNodeRange(v.Size(), node);
+            assert(first == covered);
+            covered = last;
+            const int page_node = NodeOfPage(v.begin() + first);
+            assert(page_node == -1 || static_cast<size_t>(page_node) == topology.NodeId(node));
+        }
+        assert(covered == SIZE);
+
+        // Привязка к узлу сохраняется в копии, и её страницы лежат на нём
+        const size_t node = topology.NodeId(topology.NodeCount() - 1);
+        NumaDoubles bound(parallel_tag, v, NumaAllocator<double>(NumaPolicy::Bind(node)));
+        assert(bound.GetAllocator().Policy() == NumaPolicy::Bind(node));
+        assert(bound.GetAllocator() != v.GetAllocator());
+        const int page_node = NodeOfPage(bound.begin() + SIZE / 2);
+        assert(page_node == -1 || static_cast<size_t>(page_node) == node);
+
+        NumaDoubles interleaved(parallel_tag, SIZE, NumaAllocator<double>(NumaPolicy::Interleave()));
+        interleaved = bound;
+        assert(interleaved.GetAllocator().Policy().mode == NumaPolicy::Mode::Interleave && interleaved[SIZE - 1] == 0.0);
+
+        // Маленькие буферы идут через operator new
+        NumaDoubles small(16, NumaAllocator<double>(NumaPolicy::Bind(node)));
+        small.PushBack(1.0);
+        assert(small.Size() == 17 && small[16] == 1.0);
+    }
+    {
+        // Исключение в одной из частей: созданные элементы всех потоков уничтожаются
+        CountdownThrower::countdown = static_cast<int>(SIZE / sizeof(CountdownThrower)) - 100;
+        try {
+            Vector<CountdownThrower, NumaAllocator<CountdownThrower>> v(parallel_tag, SIZE / sizeof(CountdownThrower));
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(CountdownThrower::alive == 0);
+    }
+    {
+        // Несуществующий узел — ошибка mbind
+        try {
+            Vector<double, NumaAllocator<double>> v(SIZE, NumaAllocator<double>(NumaPolicy::Bind(NUMA_MAX_NODES - 1)));
+            assert(false);
+        } catch (const std::system_error&) {
+        }
+    }
+}
+
+void Test34() {
+    const SimdLevel original = GetSimdLevel();
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        SetSimdLevel(level);
+        {
+            BitVector<> bits;
+            for (size_t i = 0; i < 1000; ++i) {
+                bits.PushBack(i % 3 == 0);
+            }
+            assert(bits.Size() == 1000 && bits.Capacity() == 1024 && bits.WordCount() == 16);
+            assert(bits[0] && !bits[1] && bits[999] && bits.Count() == 334);
+
+            bits[1] = true;
+            bits[0] = bits[2];
+            bits[999].Flip();
+            assert(!bits[0] && bits[1] && !bits[999] && bits.Count() == 333);
+
+            // Обход установленных битов
+            size_t visited = 0;
+            size_t previous = 0;
+            for (size_t i = bits.FindFirst(); i < bits.Size(); i = bits.FindNext(i)) {
+                assert(bits[i] && (visited == 0 || i > previous));
+                previous = i;
+                ++visited;
+            }
+            assert(visited == 333 && bits.FindFirst() == 1 && bits.FindNext(996) == bits.Size());
+
+            bits.PopBack();
+            bits.Resize(1100, true);
+            assert(bits.Size() == 1100 && bits[999] && bits[1099] && bits.Count() == 333 + 101);
+            bits.Resize(10);
+            assert(bits.Count() == 4);
+            // Хвост последнего слова обнулён: расширение нулями не возвращает старые биты
+            bits.Resize(1000);
+            assert(bits.Count() == 4);
+        }
+        {
+            // Редкие биты далеко друг от друга: поиск пропускает пустые слова
+            const size_t SIZE = 100000;
+            BitVector<> sparse(SIZE);
+            assert(sparse.Count() == 0 && sparse.FindFirst() == SIZE);
+            sparse[SIZE - 1] = true;
+            sparse[64 * 37 + 6] = true;
+            assert(sparse.FindFirst() == 64 * 37 + 6 && sparse.FindNext(64 * 37 + 6) == SIZE - 1);
+
+            BitVector<> ones(SIZE, true);
+            assert(ones.Count() == SIZE);
+            BitVector<> evens(SIZE);
+            for (size_t i = 0; i < SIZE; i += 2) {
+                evens[i] = true;
+            }
+            BitVector<> result = ones;
+            result.Xor(evens);
+            assert(result.Count() == SIZE / 2 && !result[0] && result[1]);
+            result.Or(sparse);
+            assert(result.Count() == SIZE / 2 + 1);
+            result.And(evens);
+            assert(result.Count() == 1 && result.FindFirst() == 64 * 37 + 6);
+            ones.And(evens);
+            assert(ones == evens && ones != result);
+        }
+    }
+    SetSimdLevel(original);
+    {
+        BitVector<> empty;
+        assert(empty.Count() == 0 && empty.FindFirst() == 0 && empty.Capacity() == 0);
+        BitVector<> moved = std::move(empty);
+        moved.PushBack(true);
+        BitVector<> copy;
+        copy = moved;
+        assert(copy.Size() == 1 && copy[0] && empty.Size() == 0);
+    }
+}
+
+void Test35() {
+    Obj::ResetCounters();
+    {
+        // Вставка в конец при свободном месте создаёт объект на месте, без перемещений
+        Vector<Obj> v;
+        v.Reserve(4);
+        v.EmplaceBack(1);
+        v.EmplaceBack(2, std::string("two"));
+        Obj& copy = v.EmplaceBack(v[0]);
+        assert(copy.id == 1 && v.Size() == 3 && Obj::num_moved == 0 && Obj::num_copied == 1);
+        v.EmplaceBack(v[1]);
+        // Аргумент ссылается на элемент, который переносится при росте
+        v.EmplaceBack(v[3]);
+        assert(v.Size() == 5 && v.Capacity() == 8 && v[4].id == 2 && Obj::GetAliveObjectCount() == 5);
+
+        v.PopBack(2);
+        assert(v.Size() == 3 && Obj::GetAliveObjectCount() == 3);
+        v.Truncate(3);
+        v.Truncate(1);
+        assert(v.Size() == 1 && v[0].id == 1 && Obj::GetAliveObjectCount() == 1 && v.Capacity() == 8);
+        v.PopBack(1);
+        assert(v.Size() == 0 && Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        const size_t SIZE = 1000;
+        Vector<int> v;
+        v.PushBack(-1);
+        {
+            auto session = v.BeginAppend(SIZE);
+            assert(session.Remaining() == SIZE && v.Capacity() >= SIZE + 1);
+            for (size_t i = 0; i < SIZE; ++i) {
+                session.Emplace(static_cast<int>(i));
+            }
+            assert(session.Remaining() == 0);
+        }
+        assert(v.Size() == SIZE + 1 && v[0] == -1 && v[SIZE] == static_cast<int>(SIZE) - 1);
+
+        // Сессия добавляет меньше зарезервированного; места хватает, и ёмкость не меняется
+        v.Reserve(2 * SIZE);
+        const size_t capacity = v.Capacity();
+        {
+            auto session = v.BeginAppend(10);
+            session.Emplace(7);
+        }
+        assert(v.Size() == SIZE + 2 && v[SIZE + 1] == 7 && v.Capacity() == capacity);
+    }
+    {
+        // Исключение посреди сессии: добавленные до него элементы остаются
+        Vector<Obj> v;
+        try {
+            auto session = v.BeginAppend(10);
+            Obj throwing;
+            throwing.throw_on_copy = true;
+            for (int i = 0; i < 5; ++i) {
+                session.Emplace(i);
+            }
+            session.Emplace(throwing);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 5 && v[4].id == 4 && Obj::GetAliveObjectCount() == 5);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
 int main() {
     try {
         Test1();
@@ -647,7 +2891,35 @@ int main() {
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
+        Test32();
+        Test33();
+        Test34();
+        Test35();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
     }
@@ -0,0 +1,297 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Заголовок в начале файла MappedVector. Размер и ёмкость хранятся прямо
+// в отображённой памяти, поэтому изменения видны после повторного открытия
+struct MappedVectorHeader {
+    static constexpr uint64_t MAGIC = 0x524F544345564D41;  // "AMVECTOR"
+    static constexpr uint32_t VERSION = 1;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t element_size;
+    uint64_t tag;
+    uint64_t size;
+    uint64_t capacity;
+};
+
+// Вектор тривиально копируемых записей, хранящийся в файле, отображённом через mmap.
+// Открытие не читает данные: страницы подгружаются по первому обращению,
+// Prefetch() заранее просит ядро их прочитать. Рост — ftruncate и повторное отображение.
+// Tag отличает форматы записей: файл с другим тегом или размером элемента не откроется.
+// Перемещённый вектор пуст и не связан с файлом: расти он не может
+template <typename T, uint64_t Tag = 0, typename Growth = DoublingGrowth>
+class MappedVector {
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector requires trivially copyable elements");
+
+public:
+    // Данные начинаются после заголовка, выровненного под кэш-линию
+    static constexpr size_t HEADER_SIZE = 64;
+    static_assert(sizeof(MappedVectorHeader) <= HEADER_SIZE);
+    static_assert(alignof(T) <= HEADER_SIZE, "Element alignment exceeds MappedVector header size");
+
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    iterator begin() noexcept {
+        return Data();
+    }
+    iterator end() noexcept {
+        return Data() + Size();
+    }
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+    const_iterator end() const noexcept {
+        return Data() + Size();
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Открывает файл или создаёт пустой вектор, если файла нет или он пуст.
+    // При ошибках системных вызовов бросает std::system_error,
+    // при несовпадении формата — std::runtime_error
+    explicit MappedVector(const std::string& path) {
+        fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            ThrowSystemError("open");
+        }
+        try {
+            Open();
+        } catch (...) {
+            Close();
+            throw;
+        }
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , base_(std::exchange(other.base_, nullptr))
+        , length_(std::exchange(other.length_, 0))
+    {}
+
+    MappedVector& operator=(MappedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Close();
+            fd_ = std::exchange(rhs.fd_, -1);
+            base_ = std::exchange(rhs.base_, nullptr);
+            length_ = std::exchange(rhs.length_, 0);
+        }
+        return *this;
+    }
+
+    ~MappedVector() {
+        Close();
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return base_ != nullptr ? GetHeader().size : 0;
+    }
+
+    [[nodiscard]] size_t Capacity() const noexcept {
+        return base_ != nullptr ? GetHeader().capacity : 0;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<MappedVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        return Data()[index];
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        if (base_ == nullptr) {
+            throw std::logic_error("MappedVector has been moved from");
+        }
+        if (new_capacity > (SIZE_MAX - HEADER_SIZE) / sizeof(T)) {
+            throw std::length_error("MappedVector capacity is too large");
+        }
+        const size_t new_length = HEADER_SIZE + new_capacity * sizeof(T);
+        if (ftruncate(fd_, static_cast<off_t>(new_length)) != 0) {
+            ThrowSystemError("ftruncate");
+        }
+        Remap(new_length);
+        GetHeader().capacity = new_capacity;
+    }
+
+    void Resize(size_t new_size) {
+        Reserve(new_size);
+        if (new_size > Size()) {
+            std::uninitialized_value_construct_n(Data() + Size(), new_size - Size());
+        }
+        if (base_ != nullptr) {
+            GetHeader().size = new_size;
+        }
+    }
+
+    void Clear() noexcept {
+        if (base_ != nullptr) {
+            GetHeader().size = 0;
+        }
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        const size_t size = Size();
+        if (size == Capacity()) {
+            // Аргументы могут ссылаться на элементы, которые переедут при переотображении
+            T value(std::forward<Args>(args)...);
+            Reserve(std::max(Growth::NextCapacity(size, sizeof(T)), size + 1));
+            new (Data() + size) T(value);
+        } else {
+            new (Data() + size) T(std::forward<Args>(args)...);
+        }
+        GetHeader().size = size + 1;
+        return Data()[size];
+    }
+
+    void PopBack() noexcept {
+        assert(Size() > 0);
+        --GetHeader().size;
+    }
+
+    // Просит ядро заранее подгрузить страницы с элементами
+    void Prefetch() const noexcept {
+        if (base_ != nullptr) {
+            madvise(base_, length_, MADV_WILLNEED);
+        }
+    }
+
+    // Синхронно сбрасывает изменённые страницы на диск
+    void Sync() const {
+        if (base_ != nullptr && msync(base_, length_, MS_SYNC) != 0) {
+            ThrowSystemError("msync");
+        }
+    }
+
+private:
+    [[noreturn]] static void ThrowSystemError(const char* what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    MappedVectorHeader& GetHeader() noexcept {
+        return *reinterpret_cast<MappedVectorHeader*>(base_);
+    }
+
+    const MappedVectorHeader& GetHeader() const noexcept {
+        return *reinterpret_cast<const MappedVectorHeader*>(base_);
+    }
+
+    T* Data() noexcept {
+        return base_ != nullptr ? reinterpret_cast<T*>(static_cast<char*>(base_) + HEADER_SIZE) : nullptr;
+    }
+
+    const T* Data() const noexcept {
+        return const_cast<MappedVector&>(*this).Data();
+    }
+
+    // Проверяет только заголовок и отображает файл целиком, не касаясь данных
+    void Open() {
+        struct stat st {};
+        if (fstat(fd_, &st) != 0) {
+            ThrowSystemError("fstat");
+        }
+        const auto file_size = static_cast<size_t>(st.st_size);
+        if (file_size == 0) {
+            if (ftruncate(fd_, HEADER_SIZE) != 0) {
+                ThrowSystemError("ftruncate");
+            }
+            Map(HEADER_SIZE);
+            GetHeader() = {MappedVectorHeader::MAGIC, MappedVectorHeader::VERSION, sizeof(T), Tag, 0, 0};
+            return;
+        }
+
+        MappedVectorHeader header{};
+        if (file_size < HEADER_SIZE || pread(fd_, &header, sizeof(header), 0) != sizeof(header)) {
+            throw std::runtime_error("MappedVector file is truncated");
+        }
+        if (header.magic != MappedVectorHeader::MAGIC || header.version != MappedVectorHeader::VERSION) {
+            throw std::runtime_error("Not a MappedVector file");
+        }
+        if (header.element_size != sizeof(T) || header.tag != Tag) {
+            throw std::runtime_error("MappedVector file holds a different element type");
+        }
+        if (header.size > header.capacity || header.capacity > (file_size - HEADER_SIZE) / sizeof(T)) {
+            throw std::runtime_error("MappedVector file is truncated");
+        }
+        Map(HEADER_SIZE + header.capacity * sizeof(T));
+    }
+
+    void Map(size_t length) {
+        void* base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (base == MAP_FAILED) {
+            ThrowSystemError("mmap");
+        }
+        base_ = base;
+        length_ = length;
+    }
+
+    void Remap(size_t new_length) {
+#ifdef __linux__
+        void* base = mremap(base_, length_, new_length, MREMAP_MAYMOVE);
+        if (base == MAP_FAILED) {
+            ThrowSystemError("mremap");
+        }
+        base_ = base;
+        length_ = new_length;
+#else
+        void* base = mmap(nullptr, new_length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (base == MAP_FAILED) {
+            ThrowSystemError("mmap");
+        }
+        munmap(base_, length_);
+        base_ = base;
+        length_ = new_length;
+#endif
+    }
+
+    void Close() noexcept {
+        if (base_ != nullptr) {
+            munmap(base_, length_);
+            base_ = nullptr;
+            length_ = 0;
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd_ = -1;
+    void* base_ = nullptr;
+    size_t length_ = 0;
+};
@@ -0,0 +1,389 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <string>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Размещение страниц больших буферов по узлам NUMA. Буферы от NUMA_MIN_MAPPED_BYTES
+// выделяются через mmap и получают политику mbind: чередование страниц по узлам или
+// привязку к узлам. Политика Local оставляет размещение первому касанию, а конструирование
+// с parallel_tag касается страниц потоками, закреплёнными за узлами:
+//   Vector<double, NumaAllocator<double>> v(parallel_tag, n, NumaAllocator<double>(NumaPolicy::Local()));
+// Часть NumaNodeRange(n, node) лежит на узле node, и обрабатывать её стоит потокам этого узла.
+// mbind вызывается напрямую системным вызовом, поэтому libnuma не нужна
+inline constexpr size_t NUMA_MIN_MAPPED_BYTES = size_t{1} << 20;
+// Узлы задаются битовой маской
+inline constexpr size_t NUMA_MAX_NODES = 64;
+
+// Политика размещения буфера
+struct NumaPolicy {
+    enum class Mode {
+        Local,       // первое касание: страница попадает на узел коснувшегося её потока
+        Interleave,  // страницы по очереди на узлах маски
+        Bind,        // страницы только на узлах маски
+    };
+
+    static NumaPolicy Local() noexcept {
+        return {Mode::Local, 0};
+    }
+
+    // Пустая маска — все узлы системы
+    static NumaPolicy Interleave(uint64_t nodes = 0) noexcept {
+        return {Mode::Interleave, nodes};
+    }
+
+    // node — номер узла в системе, как в NumaTopology::NodeId
+    static NumaPolicy Bind(size_t node) noexcept {
+        assert(node < NUMA_MAX_NODES);
+        return {Mode::Bind, uint64_t{1} << node};
+    }
+
+    bool operator==(const NumaPolicy& other) const noexcept {
+        return mode == other.mode && nodes == other.nodes;
+    }
+
+    bool operator!=(const NumaPolicy& other) const noexcept {
+        return !(*this == other);
+    }
+
+    Mode mode = Mode::Local;
+    uint64_t nodes = 0;
+};
+
+// Узлы системы и их процессоры, прочитанные из /sys/devices/system/node при первом обращении.
+// Без NUMA (или вне Linux) — один узел со всеми процессорами
+class NumaTopology {
+public:
+    static const NumaTopology& Instance() {
+        static const NumaTopology* instance = new NumaTopology();
+        return *instance;
+    }
+
+    [[nodiscard]] size_t NodeCount() const noexcept {
+        return nodes_.Size();
+    }
+
+    // Номер узла в системе; номера могут идти с пропусками
+    [[nodiscard]] size_t NodeId(size_t index) const noexcept {
+        return nodes_[index].id;
+    }
+
+    // Число процессоров узла, не меньше 1
+    [[nodiscard]] size_t CpuCount(size_t index) const noexcept {
+        return nodes_[index].cpu_count;
+    }
+
+    // Маска всех узлов
+    [[nodiscard]] uint64_t AllNodes() const noexcept {
+        uint64_t mask = 0;
+        for (const Node& node : nodes_) {
+            mask |= uint64_t{1} << node.id;
+        }
+        return mask;
+    }
+
+#ifdef __linux__
+    // Закрепляет текущий поток за процессорами узла. false, если не удалось
+    bool PinCurrentThread(size_t index) const noexcept {
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &nodes_[index].cpus) == 0;
+    }
+#endif
+
+private:
+    struct Node {
+        size_t id = 0;
+        size_t cpu_count = 1;
+#ifdef __linux__
+        cpu_set_t cpus;
+#endif
+    };
+
+    NumaTopology() {
+#ifdef __linux__
+        ForEachInList(ReadLine("/sys/devices/system/node/online"), [this](size_t id) {
+            if (id >= NUMA_MAX_NODES) {
+                return;
+            }
+            Node node;
+            node.id = id;
+            CPU_ZERO(&node.cpus);
+            size_t cpu_count = 0;
+            ForEachInList(ReadLine("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist"),
+                          [&](size_t cpu) {
+                              if (cpu < CPU_SETSIZE) {
+                                  CPU_SET(cpu, &node.cpus);
+                                  ++cpu_count;
+                              }
+                          });
+            // Узел без процессоров (только память) заполняют потоки остальных узлов
+            if (cpu_count == 0) {
+                return;
+            }
+            node.cpu_count = cpu_count;
+            nodes_.PushBack(node);
+        });
+        if (nodes_.Size() == 0) {
+            Node node;
+            CPU_ZERO(&node.cpus);
+            if (sched_getaffinity(0, sizeof(cpu_set_t), &node.cpus) != 0) {
+                CPU_SET(0, &node.cpus);
+            }
+            node.cpu_count = std::max(CPU_COUNT(&node.cpus), 1);
+            nodes_.PushBack(node);
+        }
+#else
+        nodes_.PushBack(Node{0, std::max<size_t>(std::thread::hardware_concurrency(), 1)});
+#endif
+    }
+
+    static std::string ReadLine(const std::string& path) {
+        std::ifstream input(path);
+        std::string line;
+        std::getline(input, line);
+        return line;
+    }
+
+    // Разбирает список вида "0-3,8,10-11"
+    template <typename Callback>
+    static void ForEachInList(const std::string& list, Callback callback) {
+        size_t pos = 0;
+        while (pos < list.size()) {
+            size_t end = 0;
+            size_t first = 0;
+            try {
+                first = std::stoul(list.substr(pos), &end);
+            } catch (const std::logic_error&) {
+                return;
+            }
+            pos += end;
+            size_t last = first;
+            if (pos < list.size() && list[pos] == '-') {
+                ++pos;
+                try {
+                    last = std::stoul(list.substr(pos), &end);
+                } catch (const std::logic_error&) {
+                    return;
+                }
+                pos += end;
+            }
+            for (size_t i = first; i <= last; ++i) {
+                callback(i);
+            }
+            if (pos < list.size() && list[pos] == ',') {
+                ++pos;
+            } else {
+                return;
+            }
+        }
+    }
+
+    Vector<Node> nodes_;
+};
+
+// Часть [0, count) элементов, которую параллельное конструирование с политикой Local
+// размещает на узле с индексом node_index (из NumaTopology)
+inline std::pair<size_t, size_t> NumaNodeRange(size_t count, size_t node_index) {
+    const size_t nodes = NumaTopology::Instance().NodeCount();
+    assert(node_index < nodes);
+    return {vector_detail::ChunkBound(count, nodes, node_index), vector_detail::ChunkBound(count, nodes, node_index + 1)};
+}
+
+namespace vector_detail {
+
+#ifdef __linux__
+// Восстанавливает привязку текущего потока к процессорам: часть 0 выполняется в вызывающем потоке
+class AffinityGuard {
+public:
+    AffinityGuard() noexcept {
+        saved_ = pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus_) == 0;
+    }
+
+    AffinityGuard(const AffinityGuard&) = delete;
+    AffinityGuard& operator=(const AffinityGuard&) = delete;
+
+    ~AffinityGuard() {
+        if (saved_) {
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus_);
+        }
+    }
+
+private:
+    cpu_set_t cpus_;
+    bool saved_ = false;
+};
+
+// Значения MPOL_* из ABI ядра (numaif.h)
+inline constexpr int NUMA_MPOL_BIND = 2;
+inline constexpr int NUMA_MPOL_INTERLEAVE = 3;
+
+// Назначает политику диапазону страниц. Ядро без NUMA (ENOSYS) политику игнорирует
+inline void ApplyNumaPolicy(void* ptr, size_t length, const NumaPolicy& policy) {
+    if (policy.mode == NumaPolicy::Mode::Local) {
+        return;
+    }
+    unsigned long mask = policy.nodes != 0 ? policy.nodes : NumaTopology::Instance().AllNodes();
+    const int mode = policy.mode == NumaPolicy::Mode::Bind ? NUMA_MPOL_BIND : NUMA_MPOL_INTERLEAVE;
+    // Ядро читает maxnode - 1 бит маски
+    if (syscall(SYS_mbind, ptr, length, mode, &mask, NUMA_MAX_NODES + 1, 0) != 0 && errno != ENOSYS) {
+        throw std::system_error(errno, std::generic_category(), "mbind");
+    }
+}
+#endif
+
+}  // namespace vector_detail
+
+// Аллокатор с политикой размещения NUMA. Буферы меньше NUMA_MIN_MAPPED_BYTES и платформы
+// без mmap используют operator new. Копии аллокатора с разными политиками не равны,
+// поэтому присваивание векторов с разными политиками переносит элементы в буфер получателя
+template <typename T>
+class NumaAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = NumaAllocator<U>;
+    };
+
+    NumaAllocator() noexcept = default;
+
+    explicit NumaAllocator(NumaPolicy policy) noexcept
+        : policy_(policy)
+    {}
+
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U>& other) noexcept
+        : policy_(other.Policy())
+    {}
+
+    [[nodiscard]] NumaPolicy Policy() const noexcept {
+        return policy_;
+    }
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n * sizeof(T);
+#ifdef __linux__
+        if (IsMapped(bytes)) {
+            const size_t length = RoundUpToPage(bytes);
+            void* ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            try {
+                vector_detail::ApplyNumaPolicy(ptr, length, policy_);
+            } catch (...) {
+                munmap(ptr, length);
+                throw;
+            }
+            return static_cast<T*>(ptr);
+        }
+#endif
+        return static_cast<T*>(operator new(bytes, std::align_val_t{alignof(T)}));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (!IsMapped(bytes)) {
+            operator delete(p, std::align_val_t{alignof(T)});
+            return;
+        }
+#ifdef __linux__
+        munmap(p, RoundUpToPage(bytes));
+#endif
+    }
+
+    // Хук для Vector с parallel_tag. При политике Local каждая часть NumaNodeRange
+    // делится между потоками своего узла, закреплёнными за его процессорами, и страницы
+    // при первом касании попадают на этот узел. При Bind потоки закрепляются за первым узлом
+    // маски, при Interleave размещение от потоков не зависит
+    template <typename Action, typename Rollback>
+    void parallel_chunks(size_t count, Action action, Rollback rollback) const {
+        const NumaTopology& topology = NumaTopology::Instance();
+        if (policy_.mode == NumaPolicy::Mode::Interleave || !IsMapped(count * sizeof(T))) {
+            vector_detail::ParallelChunks(count, action, rollback);
+            return;
+        }
+        size_t first_node = 0;
+        size_t node_count = topology.NodeCount();
+        if (policy_.mode == NumaPolicy::Mode::Bind) {
+            while (first_node + 1 < topology.NodeCount() && (policy_.nodes >> topology.NodeId(first_node) & 1) == 0) {
+                ++first_node;
+            }
+            node_count = 1;
+        }
+        // Потоков на узел — сколько окупается на его доле элементов, но не больше процессоров узла
+        size_t cpus = topology.CpuCount(first_node);
+        for (size_t node = first_node; node < first_node + node_count; ++node) {
+            cpus = std::min(cpus, topology.CpuCount(node));
+        }
+        const size_t per_node = std::clamp<size_t>(count / node_count / vector_detail::PARALLEL_MIN_CHUNK, 1, cpus);
+        const size_t chunks = node_count * per_node;
+        vector_detail::ParallelChunksOn(
+            chunks,
+            [count, node_count, per_node](size_t chunk) {
+                const size_t node = chunk / per_node;
+                if (node == node_count) {
+                    return count;
+                }
+                const size_t node_first = vector_detail::ChunkBound(count, node_count, node);
+                const size_t node_size = vector_detail::ChunkBound(count, node_count, node + 1) - node_first;
+                return node_first + vector_detail::ChunkBound(node_size, per_node, chunk % per_node);
+            },
+            [&](size_t chunk, size_t first, size_t last) {
+#ifdef __linux__
+                vector_detail::AffinityGuard guard;
+                topology.PinCurrentThread(first_node + chunk / per_node);
+#endif
+                action(first, last);
+            },
+            rollback);
+    }
+
+    bool operator==(const NumaAllocator& other) const noexcept {
+        return policy_ == other.policy_;
+    }
+
+    bool operator!=(const NumaAllocator& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    static bool IsMapped([[maybe_unused]] size_t bytes) noexcept {
+#ifdef __linux__
+        return bytes >= NUMA_MIN_MAPPED_BYTES;
+#else
+        return false;
+#endif
+    }
+
+#ifdef __linux__
+    static size_t RoundUpToPage(size_t bytes) noexcept {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) / page * page;
+    }
+#endif
+
+    NumaPolicy policy_;
+};
@@ -0,0 +1,307 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Параллельные сортировка и разбиение непрерывного хранилища Vector. Части сортируются
+// в своих потоках (как в ParallelChunks), затем соседние отсортированные части попарно
+// сливаются, каждая пара слияния — в своём потоке. Слиянию нужен буфер на Size() элементов:
+// он выделяется одной RawMemory, элементы переносятся туда в сырую память, и между
+// вызовами буфер можно переиспользовать, передавая его явно. Компаратор и предикат
+// вызываются из нескольких потоков одновременно.
+// Если компаратор бросит исключение, сортировка оставит в векторе все его элементы
+// в неопределённом порядке. Типы, перемещение которых может бросать, при сортировке
+// копируются, как при росте Vector, но исключение из самого копирования даёт только
+// базовую гарантию: элементы остаются корректными, а значения могут теряться и повторяться.
+// Разбиение меняет элементы местами и даёт ту же гарантию, если обмен не бросает
+
+namespace vector_detail {
+
+// Выполняет task(i) для i из [0, count), каждую задачу в своём потоке (task(0) — в текущем).
+// Пробрасывает исключение первой неудачной задачи после завершения всех
+template <typename Task>
+void ParallelInvoke(size_t count, Task task) {
+    if (count == 1) {
+        task(size_t{0});
+        return;
+    }
+    std::unique_ptr<std::exception_ptr[]> errors;
+    std::unique_ptr<std::thread[]> threads;
+    try {
+        errors = std::make_unique<std::exception_ptr[]>(count);
+        threads = std::make_unique<std::thread[]>(count);
+    } catch (const std::bad_alloc&) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+    auto run = [&](size_t i) noexcept {
+        try {
+            task(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    for (size_t i = 1; i < count; ++i) {
+        try {
+            threads[i] = std::thread(run, i);
+        } catch (...) {
+            run(i);
+        }
+    }
+    run(0);
+    for (size_t i = 1; i < count; ++i) {
+        if (threads[i].joinable()) {
+            threads[i].join();
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (errors[i] != nullptr) {
+            std::rethrow_exception(errors[i]);
+        }
+    }
+}
+
+// Переставлять элементы перемещением можно, если оно не бросает или копирования нет;
+// иначе они копируются, чтобы при ошибке исходное значение осталось на месте
+template <typename T>
+inline constexpr bool sort_by_move_v =
+    (std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>) ||
+    !std::is_copy_constructible_v<T> || !std::is_copy_assignable_v<T>;
+
+// std::sort теряет элемент, отложенный во временную переменную, если компаратор бросит
+// посреди вставки, поэтому им сортируется, только когда ни компаратор, ни перемещения не бросают
+template <typename T, typename Compare>
+inline constexpr bool std_sort_safe_v =
+    std::is_nothrow_invocable_v<Compare&, T&, T&> && std::is_nothrow_move_constructible_v<T> &&
+    std::is_nothrow_move_assignable_v<T>;
+
+// Присваивание для слияния: копирование, если перемещение может бросить,
+// чтобы при ошибке исходное значение осталось на месте
+template <typename T>
+void MoveOrCopyAssign(T& to, T& from) {
+    if constexpr (std::is_nothrow_move_assignable_v<T> || !std::is_copy_assignable_v<T>) {
+        to = std::move(from);
+    } else {
+        to = from;
+    }
+}
+
+// Устойчиво сливает отсортированные [first, middle) и [middle, last), перенося левую часть
+// в сырую память scratch. Свободные места в данных всегда образуют [out, out + остаток слева),
+// поэтому при исключении остаток возвращается на них
+template <typename T, typename Compare>
+void MergeWithScratch(T* first, T* middle, T* last, T* scratch, Compare& comp) {
+    const size_t left = middle - first;
+    T* a = scratch;
+    T* a_end = scratch + left;
+    T* b = middle;
+    T* out = first;
+    if constexpr (is_trivially_relocatable_v<T>) {
+        Relocate(first, left, scratch);
+        try {
+            while (a != a_end && b != last) {
+                if (comp(*b, *a)) {
+                    Relocate(b++, 1, out++);
+                } else {
+                    Relocate(a++, 1, out++);
+                }
+            }
+        } catch (...) {
+            Relocate(a, a_end - a, out);
+            throw;
+        }
+        Relocate(a, a_end - a, out);
+    } else {
+        UninitializedMoveOrCopyN(first, left, scratch);
+        try {
+            while (a != a_end && b != last) {
+                if (comp(*b, *a)) {
+                    MoveOrCopyAssign(*out++, *b++);
+                } else {
+                    MoveOrCopyAssign(*out++, *a++);
+                }
+            }
+            for (; a != a_end; ++a) {
+                MoveOrCopyAssign(*out++, *a);
+            }
+        } catch (...) {
+            try {
+                for (; a != a_end; ++a) {
+                    MoveOrCopyAssign(*out++, *a);
+                }
+            } catch (...) {
+            }
+            std::destroy(scratch, a_end);
+            throw;
+        }
+        std::destroy(scratch, a_end);
+    }
+}
+
+// Начальные отрезки сортируются вставками, затем сливаются снизу вверх
+inline constexpr size_t SORT_RUN = 32;
+
+// Компаратор вызывается только до перестановки, поэтому его исключение ничего не теряет.
+// При копировании значение вставляемого элемента хранится в value, а место без своего
+// значения (hole) при исключении занимает value
+template <typename T, typename Compare>
+void InsertionSort(T* first, T* last, Compare& comp) {
+    for (T* it = first + 1; it < last; ++it) {
+        T* position = std::upper_bound(first, it, *it, comp);
+        if constexpr (sort_by_move_v<T>) {
+            std::rotate(position, it, it + 1);
+        } else if (position != it) {
+            const T value(*it);
+            T* hole = it;
+            try {
+                for (; hole != position; --hole) {
+                    *hole = *(hole - 1);
+                }
+                *hole = value;
+            } catch (...) {
+                try {
+                    *hole = value;
+                } catch (...) {
+                }
+                throw;
+            }
+        }
+    }
+}
+
+// Устойчивая сортировка слиянием без выделений: scratch — сырая память на n элементов
+template <typename T, typename Compare>
+void StableSortWithScratch(T* first, size_t n, T* scratch, Compare& comp) {
+    for (size_t begin = 0; begin < n; begin += SORT_RUN) {
+        InsertionSort(first + begin, first + std::min(begin + SORT_RUN, n), comp);
+    }
+    for (size_t width = SORT_RUN; width < n; width *= 2) {
+        for (size_t begin = 0; begin + width < n; begin += 2 * width) {
+            MergeWithScratch(first + begin, first + begin + width, first + std::min(begin + 2 * width, n),
+                             scratch + begin, comp);
+        }
+    }
+}
+
+// Сортирует chunks частей параллельно и попарно сливает их. Число частей задаётся явно
+// (обычно ParallelChunkCount), scratch растёт до n элементов и сохраняет ёмкость
+template <bool Stable, typename T, typename Alloc, typename Compare>
+void ParallelMergeSort(T* data, size_t n, Compare comp, RawMemory<T, Alloc>& scratch, size_t chunks) {
+    if (n < 2) {
+        return;
+    }
+    chunks = std::clamp<size_t>(chunks, 1, n);
+    constexpr bool USE_STD_SORT = !Stable && std_sort_safe_v<T, Compare>;
+    if (USE_STD_SORT && chunks == 1) {
+        std::sort(data, data + n, comp);
+        return;
+    }
+    if (scratch.Capacity() < n) {
+        RawMemory<T, Alloc>(n, scratch.GetAllocator()).Swap(scratch);
+    }
+    T* buffer = scratch.GetAddress();
+
+    Vector<size_t> bounds;
+    bounds.Reserve(chunks + 1);
+    for (size_t chunk = 0; chunk <= chunks; ++chunk) {
+        bounds.PushBack(ChunkBound(n, chunks, chunk));
+    }
+    ParallelInvoke(chunks, [&](size_t chunk) {
+        Compare chunk_comp = comp;
+        T* first = data + bounds[chunk];
+        T* last = data + bounds[chunk + 1];
+        if constexpr (USE_STD_SORT) {
+            std::sort(first, last, chunk_comp);
+        } else {
+            StableSortWithScratch(first, last - first, buffer + bounds[chunk], chunk_comp);
+        }
+    });
+
+    // Слияние соседних пар частей; нечётная последняя часть переходит в следующий раунд
+    while (bounds.Size() > 2) {
+        const size_t runs = bounds.Size() - 1;
+        ParallelInvoke(runs / 2, [&](size_t pair) {
+            Compare merge_comp = comp;
+            const size_t first = bounds[2 * pair];
+            MergeWithScratch(data + first, data + bounds[2 * pair + 1], data + bounds[2 * pair + 2],
+                             buffer + first, merge_comp);
+        });
+        Vector<size_t> merged;
+        merged.Reserve(runs / 2 + 2);
+        for (size_t i = 0; i < bounds.Size(); i += 2) {
+            merged.PushBack(bounds[i]);
+        }
+        if (runs % 2 == 1) {
+            merged.PushBack(bounds[runs]);
+        }
+        bounds.Swap(merged);
+    }
+}
+
+// Разбивает chunks частей параллельно и собирает подходящие элементы в начало поворотами
+template <typename T, typename Predicate>
+T* ParallelPartitionChunks(T* data, size_t n, Predicate pred, size_t chunks) {
+    chunks = std::clamp<size_t>(chunks, 1, std::max<size_t>(n, 1));
+    if (chunks == 1) {
+        return std::partition(data, data + n, pred);
+    }
+    Vector<T*> splits(chunks);
+    ParallelInvoke(chunks, [&](size_t chunk) {
+        Predicate chunk_pred = pred;
+        splits[chunk] = std::partition(data + ChunkBound(n, chunks, chunk), data + ChunkBound(n, chunks, chunk + 1),
+                                       chunk_pred);
+    });
+    T* partition_end = splits[0];
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        partition_end = std::rotate(partition_end, data + ChunkBound(n, chunks, chunk), splits[chunk]);
+    }
+    return partition_end;
+}
+
+}  // namespace vector_detail
+
+// Неустойчивая сортировка: части — std::sort (или сортировка слиянием, если компаратор
+// или перемещения могут бросать), затем слияние
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim, typename Compare>
+void ParallelSort(Vector<T, Alloc, Growth, Stats, Reclaim>& vector, Compare comp, RawMemory<T, Alloc>& scratch) {
+    vector_detail::ParallelMergeSort<false>(vector.begin(), vector.Size(), comp, scratch,
+                                            vector_detail::ParallelChunkCount(vector.Size()));
+}
+
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim, typename Compare = std::less<>>
+void ParallelSort(Vector<T, Alloc, Growth, Stats, Reclaim>& vector, Compare comp = Compare()) {
+    RawMemory<T, Alloc> scratch(vector.GetAllocator());
+    ParallelSort(vector, comp, scratch);
+}
+
+// Устойчивая сортировка слиянием, выделяющая память только под scratch
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim, typename Compare>
+void ParallelStableSort(Vector<T, Alloc, Growth, Stats, Reclaim>& vector, Compare comp, RawMemory<T, Alloc>& scratch) {
+    vector_detail::ParallelMergeSort<true>(vector.begin(), vector.Size(), comp, scratch,
+                                           vector_detail::ParallelChunkCount(vector.Size()));
+}
+
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim, typename Compare = std::less<>>
+void ParallelStableSort(Vector<T, Alloc, Growth, Stats, Reclaim>& vector, Compare comp = Compare()) {
+    RawMemory<T, Alloc> scratch(vector.GetAllocator());
+    ParallelStableSort(vector, comp, scratch);
+}
+
+// Неустойчивое разбиение: элементы, для которых pred истинен, переходят в начало.
+// Возвращает итератор на первый элемент второй группы
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim, typename Predicate>
+typename Vector<T, Alloc, Growth, Stats, Reclaim>::iterator ParallelPartition(
+    Vector<T, Alloc, Growth, Stats, Reclaim>& vector, Predicate pred) {
+    return vector_detail::ParallelPartitionChunks(vector.begin(), vector.Size(), pred,
+                                                  vector_detail::ParallelChunkCount(vector.Size()));
+}
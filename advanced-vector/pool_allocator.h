@@ -0,0 +1,339 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+// Пул блоков степеней двойки от POOL_MIN_BLOCK до POOL_MAX_BLOCK байт со списками свободных
+// блоков в каждом потоке. Блок, освобождённый в другом потоке, уходит в очередь удалённых
+// освобождений пула-владельца (lock-free стек), и владелец забирает её целиком, когда его
+// список пуст. Блоки больше POOL_MAX_BLOCK выделяются напрямую через operator new.
+// Пул завершившегося потока не уничтожается, а переходит следующему новому потоку
+inline constexpr size_t POOL_MIN_BLOCK = 16;
+inline constexpr size_t POOL_MAX_BLOCK = size_t{64} << 10;
+// Сверх этого объёма свободные блоки пула возвращаются системе
+inline constexpr size_t POOL_MAX_CACHED_BYTES = size_t{4} << 20;
+
+// Счётчики одного пула. Накопительные, кроме cached_bytes
+struct PoolStats {
+    size_t allocations = 0;         // блоков выдано из классов размеров
+    size_t reused = 0;              // из них взято из списков свободных
+    size_t system_allocations = 0;  // блоков получено от operator new
+    size_t large_allocations = 0;   // выделений больше POOL_MAX_BLOCK мимо пула
+    size_t local_frees = 0;         // блоков освобождено в потоке пула
+    size_t remote_frees = 0;        // блоков освобождено другими потоками
+    size_t cached_bytes = 0;        // байт в списках свободных сейчас
+};
+
+namespace pool_detail {
+
+inline constexpr size_t LOG_MIN_BLOCK = 4;
+static_assert(POOL_MIN_BLOCK == size_t{1} << LOG_MIN_BLOCK);
+inline constexpr size_t CLASS_COUNT = 13;
+static_assert(POOL_MAX_BLOCK == POOL_MIN_BLOCK << (CLASS_COUNT - 1));
+inline constexpr size_t LARGE_CLASS = CLASS_COUNT;
+
+class SizeClassPool;
+
+// Заголовок перед каждым блоком: владелец (nullptr у больших блоков) и класс размера
+struct alignas(std::max_align_t) BlockHeader {
+    SizeClassPool* owner;
+    size_t size_class;
+};
+
+inline constexpr size_t HEADER_SIZE = sizeof(BlockHeader);
+
+// Свободный блок хранит ссылку на следующий в своих данных
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+inline size_t ClassSize(size_t size_class) noexcept {
+    return POOL_MIN_BLOCK << size_class;
+}
+
+inline size_t SizeClassOf(size_t bytes) noexcept {
+    size_t size_class = 0;
+    while (ClassSize(size_class) < bytes) {
+        ++size_class;
+    }
+    return size_class;
+}
+
+inline BlockHeader* HeaderOf(void* block) noexcept {
+    return reinterpret_cast<BlockHeader*>(static_cast<unsigned char*>(block) - HEADER_SIZE);
+}
+
+inline void* BlockOf(BlockHeader* header) noexcept {
+    return reinterpret_cast<unsigned char*>(header) + HEADER_SIZE;
+}
+
+inline void* AllocateWithHeader(size_t bytes, SizeClassPool* owner, size_t size_class) {
+    auto* header = static_cast<BlockHeader*>(::operator new(HEADER_SIZE + bytes));
+    header->owner = owner;
+    header->size_class = size_class;
+    return BlockOf(header);
+}
+
+// Пул одного потока. Списками свободных и счётчиками владельца пользуется только
+// поток-владелец; очередь удалённых освобождений и remote_frees — любые потоки
+class SizeClassPool {
+public:
+    void* Allocate(size_t size_class) {
+        FreeBlock* block = free_[size_class];
+        if (block == nullptr) {
+            CollectRemoteFrees();
+            block = free_[size_class];
+        }
+        Bump(allocations_);
+        if (block == nullptr) {
+            Bump(system_allocations_);
+            return AllocateWithHeader(ClassSize(size_class), this, size_class);
+        }
+        free_[size_class] = block->next;
+        cached_bytes_.store(cached_bytes_.load(std::memory_order_relaxed) - ClassSize(size_class),
+                            std::memory_order_relaxed);
+        Bump(reused_);
+        return block;
+    }
+
+    void CountLargeAllocation() noexcept {
+        Bump(large_allocations_);
+    }
+
+    // Вызывается в потоке-владельце
+    void Free(void* block) noexcept {
+        Bump(local_frees_);
+        Cache(block);
+    }
+
+    // Вызывается в любом потоке
+    void RemoteFree(void* block) noexcept {
+        auto* free_block = static_cast<FreeBlock*>(block);
+        FreeBlock* head = remote_.load(std::memory_order_relaxed);
+        do {
+            free_block->next = head;
+        } while (!remote_.compare_exchange_weak(head, free_block, std::memory_order_release, std::memory_order_relaxed));
+        remote_frees_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Возвращает системе все свободные блоки: пул переходит к другому потоку
+    void ReleaseCached() noexcept {
+        CollectRemoteFrees();
+        for (FreeBlock*& head : free_) {
+            while (head != nullptr) {
+                FreeBlock* next = head->next;
+                ::operator delete(HeaderOf(head));
+                head = next;
+            }
+        }
+        cached_bytes_.store(0, std::memory_order_relaxed);
+    }
+
+    PoolStats Stats() const noexcept {
+        PoolStats stats;
+        stats.allocations = allocations_.load(std::memory_order_relaxed);
+        stats.reused = reused_.load(std::memory_order_relaxed);
+        stats.system_allocations = system_allocations_.load(std::memory_order_relaxed);
+        stats.large_allocations = large_allocations_.load(std::memory_order_relaxed);
+        stats.local_frees = local_frees_.load(std::memory_order_relaxed);
+        stats.remote_frees = remote_frees_.load(std::memory_order_relaxed);
+        stats.cached_bytes = cached_bytes_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    SizeClassPool* next_abandoned = nullptr;
+
+private:
+    // Счётчик с единственным писателем: обычная запись без атомарного сложения
+    static void Bump(std::atomic<size_t>& counter) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void Cache(void* block) noexcept {
+        const size_t size_class = HeaderOf(block)->size_class;
+        const size_t cached = cached_bytes_.load(std::memory_order_relaxed);
+        if (cached + ClassSize(size_class) > POOL_MAX_CACHED_BYTES) {
+            ::operator delete(HeaderOf(block));
+            return;
+        }
+        auto* free_block = static_cast<FreeBlock*>(block);
+        free_block->next = free_[size_class];
+        free_[size_class] = free_block;
+        cached_bytes_.store(cached + ClassSize(size_class), std::memory_order_relaxed);
+    }
+
+    void CollectRemoteFrees() noexcept {
+        FreeBlock* block = remote_.exchange(nullptr, std::memory_order_acquire);
+        while (block != nullptr) {
+            FreeBlock* next = block->next;
+            Cache(block);
+            block = next;
+        }
+    }
+
+    FreeBlock* free_[CLASS_COUNT] = {};
+    std::atomic<FreeBlock*> remote_ = nullptr;
+
+    std::atomic<size_t> allocations_ = 0;
+    std::atomic<size_t> reused_ = 0;
+    std::atomic<size_t> system_allocations_ = 0;
+    std::atomic<size_t> large_allocations_ = 0;
+    std::atomic<size_t> local_frees_ = 0;
+    std::atomic<size_t> remote_frees_ = 0;
+    std::atomic<size_t> cached_bytes_ = 0;
+};
+
+// Пулы завершившихся потоков, ожидающие нового владельца. Пулы не уничтожаются:
+// на них могут ссылаться ещё не освобождённые блоки, поэтому их число ограничено
+// наибольшим числом одновременно живших потоков
+class PoolRegistry {
+public:
+    static PoolRegistry& Instance() {
+        static PoolRegistry* instance = new PoolRegistry();
+        return *instance;
+    }
+
+    SizeClassPool* Acquire() {
+        {
+            std::lock_guard lock(mutex_);
+            if (abandoned_ != nullptr) {
+                SizeClassPool* pool = abandoned_;
+                abandoned_ = pool->next_abandoned;
+                pool->next_abandoned = nullptr;
+                return pool;
+            }
+        }
+        return new SizeClassPool();
+    }
+
+    void Abandon(SizeClassPool* pool) noexcept {
+        pool->ReleaseCached();
+        std::lock_guard lock(mutex_);
+        pool->next_abandoned = abandoned_;
+        abandoned_ = pool;
+    }
+
+private:
+    PoolRegistry() = default;
+
+    std::mutex mutex_;
+    SizeClassPool* abandoned_ = nullptr;
+};
+
+// Тривиальные thread_local доступны и после уничтожения ThreadPoolHandle при завершении потока
+inline thread_local SizeClassPool* current_pool = nullptr;
+inline thread_local bool pool_thread_exited = false;
+
+struct ThreadPoolHandle {
+    ThreadPoolHandle() {
+        current_pool = PoolRegistry::Instance().Acquire();
+    }
+
+    ~ThreadPoolHandle() {
+        PoolRegistry::Instance().Abandon(current_pool);
+        current_pool = nullptr;
+        pool_thread_exited = true;
+    }
+};
+
+// Пул текущего потока, создаётся при первом выделении. nullptr, если поток завершается
+inline SizeClassPool* CurrentPool() {
+    if (current_pool == nullptr && !pool_thread_exited) {
+        thread_local ThreadPoolHandle handle;
+    }
+    return current_pool;
+}
+
+inline void* Allocate(size_t bytes) {
+    SizeClassPool* pool = CurrentPool();
+    if (bytes > POOL_MAX_BLOCK || pool == nullptr) {
+        if (pool != nullptr) {
+            pool->CountLargeAllocation();
+        }
+        return AllocateWithHeader(bytes, nullptr, LARGE_CLASS);
+    }
+    return pool->Allocate(SizeClassOf(bytes));
+}
+
+inline void Deallocate(void* block) noexcept {
+    SizeClassPool* owner = HeaderOf(block)->owner;
+    if (owner == nullptr) {
+        ::operator delete(HeaderOf(block));
+    } else if (owner == current_pool) {
+        owner->Free(block);
+    } else {
+        owner->RemoteFree(block);
+    }
+}
+
+}  // namespace pool_detail
+
+// Счётчики пула текущего потока; нулевые, если поток ещё не выделял память
+inline PoolStats GetThreadPoolStats() noexcept {
+    return pool_detail::current_pool != nullptr ? pool_detail::current_pool->Stats() : PoolStats{};
+}
+
+// Аллокатор без состояния поверх пулов потоков. allocate_at_least отдаёт весь класс размера,
+// поэтому Vector получает ёмкость степени двойки, а удвоение при росте берёт блок
+// следующего класса, освобождённый предыдущим ростом другого вектора:
+//   Vector<Vector<int, PoolAllocator<int>>, PoolAllocator<Vector<int, PoolAllocator<int>>>>
+template <typename T>
+class PoolAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "PoolAllocator does not support over-aligned types");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U>;
+    };
+
+    struct allocation_result {
+        T* ptr;
+        size_t count;
+    };
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(pool_detail::Allocate(Bytes(n)));
+    }
+
+    allocation_result allocate_at_least(size_t n) {
+        const size_t bytes = Bytes(n);
+        T* ptr = static_cast<T*>(pool_detail::Allocate(bytes));
+        if (bytes > POOL_MAX_BLOCK) {
+            return {ptr, n};
+        }
+        return {ptr, pool_detail::ClassSize(pool_detail::SizeClassOf(bytes)) / sizeof(T)};
+    }
+
+    void deallocate(T* p, size_t /*n*/) noexcept {
+        pool_detail::Deallocate(static_cast<void*>(p));
+    }
+
+    bool operator==(const PoolAllocator&) const noexcept {
+        return true;
+    }
+
+    bool operator!=(const PoolAllocator&) const noexcept {
+        return false;
+    }
+
+private:
+    static size_t Bytes(size_t n) {
+        if (n > (SIZE_MAX - pool_detail::HEADER_SIZE) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Аллокатор для тривиально перемещаемых типов, который растит блок на месте:
+// до MmapThreshold байт через realloc, начиная с него через mmap/mremap(MREMAP_MAYMOVE),
+// когда рост сводится к перестройке таблиц страниц без копирования данных
+template <typename T, size_t MmapThreshold = size_t{32} << 20>
+class ReallocAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "ReallocAllocator does not support over-aligned types");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = ReallocAllocator<U, MmapThreshold>;
+    };
+
+    ReallocAllocator() noexcept = default;
+
+    template <typename U>
+    ReallocAllocator(const ReallocAllocator<U, MmapThreshold>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n * sizeof(T);
+        void* ptr = IsMapped(bytes) ? Map(bytes) : std::malloc(bytes);
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (IsMapped(bytes)) {
+            Unmap(p, bytes);
+        } else {
+            std::free(p);
+        }
+    }
+
+    // При ошибке бросает std::bad_alloc, исходный блок остаётся нетронутым
+    T* reallocate(T* p, size_t old_n, size_t new_n) {
+        if (p == nullptr) {
+            return new_n != 0 ? allocate(new_n) : nullptr;
+        }
+        if (new_n == 0) {
+            deallocate(p, old_n);
+            return nullptr;
+        }
+        if (new_n > SIZE_MAX / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t old_bytes = old_n * sizeof(T);
+        const size_t new_bytes = new_n * sizeof(T);
+        const bool old_mapped = IsMapped(old_bytes);
+        const bool new_mapped = IsMapped(new_bytes);
+
+        void* result = nullptr;
+        if (!old_mapped && !new_mapped) {
+            result = std::realloc(static_cast<void*>(p), new_bytes);
+        } else if (old_mapped && new_mapped) {
+            result = Remap(p, old_bytes, new_bytes);
+        } else {
+            result = new_mapped ? Map(new_bytes) : std::malloc(new_bytes);
+            if (result != nullptr) {
+                std::memcpy(result, static_cast<const void*>(p), std::min(old_bytes, new_bytes));
+                deallocate(p, old_n);
+            }
+        }
+        if (result == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(result);
+    }
+
+    bool operator==(const ReallocAllocator&) const noexcept {
+        return true;
+    }
+
+    bool operator!=(const ReallocAllocator&) const noexcept {
+        return false;
+    }
+
+private:
+    static bool IsMapped([[maybe_unused]] size_t bytes) noexcept {
+#ifdef __linux__
+        return bytes >= MmapThreshold;
+#else
+        return false;
+#endif
+    }
+
+#ifdef __linux__
+    static size_t RoundUpToPage(size_t bytes) noexcept {
+        static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page_size - 1) / page_size * page_size;
+    }
+
+    static void* Map(size_t bytes) noexcept {
+        void* ptr = mmap(nullptr, RoundUpToPage(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return ptr != MAP_FAILED ? ptr : nullptr;
+    }
+
+    static void* Remap(void* p, size_t old_bytes, size_t new_bytes) noexcept {
+        void* ptr = mremap(p, RoundUpToPage(old_bytes), RoundUpToPage(new_bytes), MREMAP_MAYMOVE);
+        return ptr != MAP_FAILED ? ptr : nullptr;
+    }
+
+    static void Unmap(void* p, size_t bytes) noexcept {
+        munmap(p, RoundUpToPage(bytes));
+    }
+#else
+    static void* Map(size_t) noexcept {
+        return nullptr;
+    }
+
+    static void* Remap(void*, size_t, size_t) noexcept {
+        return nullptr;
+    }
+
+    static void Unmap(void*, size_t) noexcept {}
+#endif
+};
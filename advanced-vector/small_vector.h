@@ -0,0 +1,274 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Вектор, хранящий до N элементов во встроенном буфере и переходящий
+// в RawMemory в куче только при переполнении
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "Inline capacity must be positive");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    iterator begin() noexcept {
+        return Data();
+    }
+    iterator end() noexcept {
+        return Data() + size_;
+    }
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+    const_iterator end() const noexcept {
+        return Data() + size_;
+    }
+    const_iterator cbegin() const noexcept {
+        return Data();
+    }
+    const_iterator cend() const noexcept {
+        return Data() + size_;
+    }
+
+    SmallVector() = default;
+
+    explicit SmallVector(size_t size)
+        : heap_(size > N ? size : 0)
+    {
+        std::uninitialized_value_construct_n(Data(), size);
+        size_ = size;
+    }
+
+    SmallVector(const SmallVector& other)
+        : heap_(other.size_ > N ? other.size_ : 0)
+    {
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.IsInline()) {
+            MoveInlineElementsFrom(other);
+        } else {
+            heap_ = std::move(other.heap_);
+            size_ = std::exchange(other.size_, 0);
+        }
+    }
+
+    SmallVector& operator=(const SmallVector& rhs) {
+        if (this != &rhs) {
+            if (rhs.size_ > Capacity()) {
+                SmallVector rhs_copy(rhs);
+                Swap(rhs_copy);
+            } else {
+                size_t count_to_copy = std::min(size_, rhs.size_);
+                std::copy(rhs.Data(), rhs.Data() + count_to_copy, Data());
+
+                if (rhs.size_ < size_) {
+                    std::destroy_n(Data() + rhs.size_, size_ - rhs.size_);
+                } else if (rhs.size_ > size_) {
+                    std::uninitialized_copy_n(rhs.Data() + size_, rhs.size_ - size_, Data() + size_);
+                }
+                size_ = rhs.size_;
+            }
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &rhs) {
+            Clear();
+            if (rhs.IsInline()) {
+                // Ёмкость любого SmallVector не меньше N, поэтому элементы помещаются в текущий буфер
+                MoveInlineElementsFrom(rhs);
+            } else {
+                heap_ = std::move(rhs.heap_);
+                size_ = std::exchange(rhs.size_, 0);
+            }
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        std::destroy_n(Data(), size_);
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] size_t Capacity() const noexcept {
+        return IsInline() ? N : heap_.Capacity();
+    }
+
+    // Элементы лежат во встроенном буфере
+    [[nodiscard]] bool IsInline() const noexcept {
+        return heap_.GetAddress() == nullptr;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SmallVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        RawMemory<T> new_data(new_capacity);
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            vector_detail::Relocate(Data(), size_, new_data.GetAddress());
+        } else {
+            vector_detail::UninitializedMoveOrCopyN(Data(), size_, new_data.GetAddress());
+            std::destroy_n(Data(), size_);
+        }
+        heap_.Swap(new_data);
+    }
+
+    void Swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>
+                                           && std::is_nothrow_swappable_v<T>) {
+        if (!IsInline() && !other.IsInline()) {
+            heap_.Swap(other.heap_);
+            std::swap(size_, other.size_);
+        } else if (IsInline() && other.IsInline()) {
+            SmallVector& larger = size_ >= other.size_ ? *this : other;
+            SmallVector& smaller = size_ >= other.size_ ? other : *this;
+            std::swap_ranges(smaller.begin(), smaller.end(), larger.begin());
+            const size_t extra = larger.size_ - smaller.size_;
+            std::uninitialized_move_n(larger.begin() + smaller.size_, extra, smaller.end());
+            std::destroy_n(larger.begin() + smaller.size_, extra);
+            std::swap(size_, other.size_);
+        } else {
+            SmallVector& on_heap = IsInline() ? other : *this;
+            SmallVector& inline_vector = IsInline() ? *this : other;
+            RawMemory<T> heap(std::move(on_heap.heap_));
+            const size_t heap_size = on_heap.size_;
+
+            // Встроенный буфер вектора в куче свободен, элементы переходят туда
+            on_heap.size_ = 0;
+            if constexpr (std::is_nothrow_move_constructible_v<T>) {
+                on_heap.MoveInlineElementsFrom(inline_vector);
+            } else {
+                try {
+                    on_heap.MoveInlineElementsFrom(inline_vector);
+                } catch (...) {
+                    on_heap.heap_ = std::move(heap);
+                    on_heap.size_ = heap_size;
+                    throw;
+                }
+            }
+            inline_vector.heap_ = std::move(heap);
+            inline_vector.size_ = heap_size;
+        }
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            std::destroy_n(Data() + new_size, size_ - new_size);
+        } else {
+            Reserve(new_size);
+            std::uninitialized_value_construct_n(Data() + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    void Clear() noexcept {
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PopBack() {
+        std::destroy_at(Data() + size_ - 1);
+        --size_;
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        iterator it = Emplace(end(), std::forward<Args>(args)...);
+        return *it;
+    }
+
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        size_t index = pos - Data();
+        if (size_ == Capacity()) {
+            return EmplaceWithReallocation(index, std::forward<Args>(args)...);
+        }
+        vector_detail::EmplaceShifted(Data(), size_, index, std::forward<Args>(args)...);
+        ++size_;
+        return Data() + index;
+    }
+
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    iterator Erase(const_iterator pos) {
+        size_t index = pos - Data();
+        vector_detail::EraseShifted(Data(), size_, index, 1);
+        --size_;
+        return Data() + index;
+    }
+
+private:
+    T* Data() noexcept {
+        return IsInline() ? std::launder(reinterpret_cast<T*>(inline_)) : heap_.GetAddress();
+    }
+
+    const T* Data() const noexcept {
+        return const_cast<SmallVector&>(*this).Data();
+    }
+
+    // Переносит элементы встроенного буфера other в пустой *this и опустошает other
+    void MoveInlineElementsFrom(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        assert(size_ == 0 && other.IsInline());
+        std::uninitialized_move_n(other.Data(), other.size_, Data());
+        std::destroy_n(other.Data(), other.size_);
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    template <typename... Args>
+    iterator EmplaceWithReallocation(size_t index, Args&&... args) {
+        RawMemory<T> new_data(size_ * 2);
+
+        new (new_data + index) T(std::forward<Args>(args)...);
+        try {
+            vector_detail::RelocateAround(Data(), size_, new_data.GetAddress(), index, 1);
+        } catch (...) {
+            std::destroy_at(new_data + index);
+            throw;
+        }
+        heap_.Swap(new_data);
+
+        ++size_;
+        return Data() + index;
+    }
+
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+    RawMemory<T> heap_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,383 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Вектор структур, хранящийся по столбцам (structure of arrays): каждое поле лежит
+// в своей RawMemory, все столбцы растут вместе под одной ёмкостью. Цикл по двум полям
+// из девяти читает только их столбцы. Column<I>() отдаёт столбец непрерывным массивом,
+// а строки доступны как кортежи ссылок:
+//   SoaVector<float, float, int> particles;
+//   particles.EmplaceBack(x, y, id);
+//   for (auto [x, y, id] : particles) { ... }
+template <typename... Fields>
+class SoaVector {
+    static_assert(sizeof...(Fields) > 0, "SoaVector requires at least one field");
+
+    static constexpr size_t COLUMN_COUNT = sizeof...(Fields);
+    using Columns = std::tuple<RawMemory<Fields>...>;
+    using Indices = std::index_sequence_for<Fields...>;
+
+    template <size_t I>
+    using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    template <bool IsConst>
+    class BasicIterator {
+        using Container = std::conditional_t<IsConst, const SoaVector, SoaVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::tuple<Fields...>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::conditional_t<IsConst, std::tuple<const Fields&...>, std::tuple<Fields&...>>;
+
+        BasicIterator() = default;
+
+        BasicIterator(Container* container, size_t index) noexcept
+            : container_(container)
+            , index_(index)
+        {}
+
+        reference operator*() const noexcept {
+            return (*container_)[index_];
+        }
+        reference operator[](difference_type offset) const noexcept {
+            return (*container_)[index_ + offset];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy = *this;
+            ++index_;
+            return copy;
+        }
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy = *this;
+            --index_;
+            return copy;
+        }
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        Container* container_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using value_type = std::tuple<Fields...>;
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    iterator begin() noexcept {
+        return {this, 0};
+    }
+    iterator end() noexcept {
+        return {this, size_};
+    }
+    const_iterator begin() const noexcept {
+        return {this, 0};
+    }
+    const_iterator end() const noexcept {
+        return {this, size_};
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    SoaVector() = default;
+
+    SoaVector(const SoaVector& other)
+        : columns_(RawMemory<Fields>(other.size_)...)
+    {
+        CopyColumns(other.columns_, columns_, other.size_);
+        size_ = other.size_;
+    }
+
+    SoaVector(SoaVector&& other) noexcept
+        : columns_(std::move(other.columns_))
+        , size_(std::exchange(other.size_, 0))
+    {}
+
+    SoaVector& operator=(const SoaVector& rhs) {
+        if (this != &rhs) {
+            SoaVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    SoaVector& operator=(SoaVector&& rhs) noexcept {
+        if (this != &rhs) {
+            SoaVector rhs_moved(std::move(rhs));
+            Swap(rhs_moved);
+        }
+        return *this;
+    }
+
+    ~SoaVector() {
+        DestroyColumns(columns_, 0, size_, Indices{});
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] size_t Capacity() const noexcept {
+        return std::get<0>(columns_).Capacity();
+    }
+
+    // Непрерывный столбец поля I из Size() элементов
+    template <size_t I>
+    Field<I>* Column() noexcept {
+        return std::get<I>(columns_).GetAddress();
+    }
+
+    template <size_t I>
+    const Field<I>* Column() const noexcept {
+        return std::get<I>(columns_).GetAddress();
+    }
+
+    template <size_t I>
+    Field<I>& Get(size_t index) noexcept {
+        assert(index < size_);
+        return std::get<I>(columns_)[index];
+    }
+
+    template <size_t I>
+    const Field<I>& Get(size_t index) const noexcept {
+        assert(index < size_);
+        return std::get<I>(columns_)[index];
+    }
+
+    reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Row(index, Indices{});
+    }
+
+    const_reference operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return const_cast<SoaVector&>(*this).Row(index, Indices{});
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > Capacity()) {
+            Reallocate(new_capacity, NoNewRow{});
+        }
+    }
+
+    void Swap(SoaVector& other) noexcept {
+        SwapColumns(columns_, other.columns_, Indices{});
+        std::swap(size_, other.size_);
+    }
+
+    void Clear() noexcept {
+        DestroyColumns(columns_, 0, size_, Indices{});
+        size_ = 0;
+    }
+
+    void PushBack(const value_type& row) {
+        std::apply(
+            [this](const Fields&... fields) {
+                EmplaceBack(fields...);
+            },
+            row);
+    }
+
+    void PushBack(value_type&& row) {
+        std::apply(
+            [this](Fields&... fields) {
+                EmplaceBack(std::move(fields)...);
+            },
+            row);
+    }
+
+    // По одному аргументу на столбец. Если конструктор какого-то поля бросит исключение,
+    // уже созданные поля строки уничтожаются, а вектор остаётся прежним
+    template <typename... Args>
+    reference EmplaceBack(Args&&... args) {
+        static_assert(sizeof...(Args) == COLUMN_COUNT, "EmplaceBack takes one argument per field");
+        auto arguments = std::forward_as_tuple(std::forward<Args>(args)...);
+        if (size_ == Capacity()) {
+            // Новая строка создаётся в новом буфере до переноса старых: аргументы
+            // могут ссылаться на элементы вектора
+            Reallocate(DoublingGrowth::NextCapacity(size_, ROW_SIZE),
+                       [this, &arguments](Columns& new_columns) {
+                           ConstructRow(new_columns, size_, std::move(arguments));
+                       });
+        } else {
+            ConstructRow(columns_, size_, std::move(arguments));
+        }
+        ++size_;
+        return (*this)[size_ - 1];
+    }
+
+    void PopBack() noexcept {
+        assert(size_ > 0);
+        --size_;
+        DestroyColumns(columns_, size_, size_ + 1, Indices{});
+    }
+
+private:
+    static constexpr size_t ROW_SIZE = (sizeof(Fields) + ...);
+
+    struct NoNewRow {
+        void operator()(Columns&) const noexcept {}
+    };
+
+    template <size_t... I>
+    reference Row(size_t index, std::index_sequence<I...>) noexcept {
+        return reference(std::get<I>(columns_)[index]...);
+    }
+
+    template <size_t I = 0, typename Arguments>
+    static void ConstructRow(Columns& columns, size_t index, Arguments&& arguments) {
+        if constexpr (I < COLUMN_COUNT) {
+            new (std::get<I>(columns) + index) Field<I>(std::get<I>(std::forward<Arguments>(arguments)));
+            try {
+                ConstructRow<I + 1>(columns, index, std::forward<Arguments>(arguments));
+            } catch (...) {
+                std::destroy_at(std::get<I>(columns) + index);
+                throw;
+            }
+        }
+    }
+
+    template <size_t I = 0>
+    static void CopyColumns(const Columns& from, Columns& to, size_t size) {
+        if constexpr (I < COLUMN_COUNT) {
+            std::uninitialized_copy_n(std::get<I>(from).GetAddress(), size, std::get<I>(to).GetAddress());
+            try {
+                CopyColumns<I + 1>(from, to, size);
+            } catch (...) {
+                std::destroy_n(std::get<I>(to).GetAddress(), size);
+                throw;
+            }
+        }
+    }
+
+    // Перемещает или копирует столбцы, которые нельзя перенести побайтово.
+    // При исключении уже перенесённые столбцы уничтожаются, исходные не меняются
+    template <size_t I = 0>
+    static void MoveColumns(Columns& from, Columns& to, size_t size) {
+        if constexpr (I < COLUMN_COUNT) {
+            constexpr bool RELOCATABLE = is_trivially_relocatable_v<Field<I>>;
+            if constexpr (!RELOCATABLE) {
+                vector_detail::UninitializedMoveOrCopyN(std::get<I>(from).GetAddress(), size,
+                                                        std::get<I>(to).GetAddress());
+            }
+            try {
+                MoveColumns<I + 1>(from, to, size);
+            } catch (...) {
+                if constexpr (!RELOCATABLE) {
+                    std::destroy_n(std::get<I>(to).GetAddress(), size);
+                }
+                throw;
+            }
+        }
+    }
+
+    // Завершает перенос: побайтово переносит тривиально перемещаемые столбцы, остальные уничтожает
+    template <size_t... I>
+    static void FinishMove(Columns& from, Columns& to, size_t size, std::index_sequence<I...>) noexcept {
+        (
+            [&] {
+                if constexpr (is_trivially_relocatable_v<Field<I>>) {
+                    vector_detail::Relocate(std::get<I>(from).GetAddress(), size, std::get<I>(to).GetAddress());
+                } else {
+                    std::destroy_n(std::get<I>(from).GetAddress(), size);
+                }
+            }(),
+            ...);
+    }
+
+    template <size_t... I>
+    static void DestroyColumns(Columns& columns, size_t first, size_t last, std::index_sequence<I...>) noexcept {
+        (std::destroy(std::get<I>(columns) + first, std::get<I>(columns) + last), ...);
+    }
+
+    template <size_t... I>
+    static void SwapColumns(Columns& lhs, Columns& rhs, std::index_sequence<I...>) noexcept {
+        (std::get<I>(lhs).Swap(std::get<I>(rhs)), ...);
+    }
+
+    // Выделяет все столбцы новой ёмкости, вызывает construct_new(new_columns), создающий строку
+    // с индексом size_ (кроме NoNewRow), и переносит элементы. При исключении вектор остаётся прежним
+    template <typename ConstructNew>
+    void Reallocate(size_t new_capacity, ConstructNew construct_new) {
+        Columns new_columns{RawMemory<Fields>(new_capacity)...};
+        construct_new(new_columns);
+        try {
+            MoveColumns(columns_, new_columns, size_);
+        } catch (...) {
+            if constexpr (!std::is_same_v<ConstructNew, NoNewRow>) {
+                DestroyColumns(new_columns, size_, size_ + 1, Indices{});
+            }
+            throw;
+        }
+        FinishMove(columns_, new_columns, size_, Indices{});
+        SwapColumns(columns_, new_columns, Indices{});
+    }
+
+    Columns columns_;
+    size_t size_ = 0;
+};
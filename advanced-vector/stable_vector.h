@@ -0,0 +1,276 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Вектор из блоков по ChunkSize элементов, каждый в своей RawMemory. Рост добавляет
+// один блок и никогда не перемещает элементы, поэтому указатели, ссылки и итераторы
+// остаются действительными, а задержка роста ограничена выделением одного блока.
+// operator[] — O(1) через таблицу блоков; степень двойки в ChunkSize сводит деление к сдвигу
+template <typename T, size_t ChunkSize = 256>
+class StableVector {
+    static_assert(ChunkSize > 0, "Chunk size must be positive");
+
+    template <bool IsConst>
+    class BasicIterator {
+        using Container = std::conditional_t<IsConst, const StableVector, StableVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        BasicIterator() = default;
+
+        BasicIterator(Container* container, size_t index) noexcept
+            : container_(container)
+            , index_(index)
+        {}
+
+        // Неконстантный итератор приводится к константному
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+            : container_(other.container_)
+            , index_(other.index_)
+        {}
+
+        reference operator*() const noexcept {
+            return (*container_)[index_];
+        }
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy = *this;
+            ++index_;
+            return copy;
+        }
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy = *this;
+            --index_;
+            return copy;
+        }
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        friend class BasicIterator<!IsConst>;
+
+        Container* container_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    iterator begin() noexcept {
+        return {this, 0};
+    }
+    iterator end() noexcept {
+        return {this, size_};
+    }
+    const_iterator begin() const noexcept {
+        return {this, 0};
+    }
+    const_iterator end() const noexcept {
+        return {this, size_};
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    StableVector() = default;
+
+    // Делегирование гарантирует вызов деструктора, если конструктор элемента бросит исключение
+    explicit StableVector(size_t size)
+        : StableVector()
+    {
+        Resize(size);
+    }
+
+    StableVector(const StableVector& other)
+        : StableVector()
+    {
+        Reserve(other.size_);
+        for (const T& value : other) {
+            EmplaceBack(value);
+        }
+    }
+
+    StableVector(StableVector&& other) noexcept
+        : chunks_(std::move(other.chunks_))
+        , size_(std::exchange(other.size_, 0))
+    {}
+
+    StableVector& operator=(const StableVector& rhs) {
+        if (this != &rhs) {
+            StableVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    StableVector& operator=(StableVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Clear();
+            chunks_ = std::move(rhs.chunks_);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    ~StableVector() {
+        Clear();
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] size_t Capacity() const noexcept {
+        return chunks_.Size() * ChunkSize;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<StableVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return chunks_[index / ChunkSize][index % ChunkSize];
+    }
+
+    void Reserve(size_t new_capacity) {
+        const size_t chunk_count = (new_capacity + ChunkSize - 1) / ChunkSize;
+        if (chunk_count > chunks_.Size()) {
+            chunks_.Reserve(chunk_count);
+            while (chunks_.Size() < chunk_count) {
+                chunks_.EmplaceBack(ChunkSize);
+            }
+        }
+    }
+
+    // Освобождает блоки, в которых не осталось элементов
+    void ShrinkToFit() {
+        const size_t chunk_count = (size_ + ChunkSize - 1) / ChunkSize;
+        while (chunks_.Size() > chunk_count) {
+            chunks_.PopBack();
+        }
+        chunks_.ShrinkToFit();
+    }
+
+    void Swap(StableVector& other) noexcept {
+        chunks_.Swap(other.chunks_);
+        std::swap(size_, other.size_);
+    }
+
+    void Resize(size_t new_size) {
+        Reserve(new_size);
+        while (size_ < new_size) {
+            EmplaceBack();
+        }
+        while (size_ > new_size) {
+            PopBack();
+        }
+    }
+
+    void Clear() noexcept {
+        while (size_ > 0) {
+            PopBack();
+        }
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Аргументы могут ссылаться на элементы вектора: они не перемещаются при росте
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            chunks_.EmplaceBack(ChunkSize);
+        }
+        T* slot = chunks_[size_ / ChunkSize] + size_ % ChunkSize;
+        new (slot) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ > 0);
+        --size_;
+        std::destroy_at(chunks_[size_ / ChunkSize] + size_ % ChunkSize);
+    }
+
+private:
+    // Таблица блоков: при её росте перемещаются только дескрипторы RawMemory
+    Vector<RawMemory<T>> chunks_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,303 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace vector_detail {
+
+// Вычисляется ли выражение на этапе компиляции. Без встроенной функции компилятора
+// считается, что да, и выбирается ветка, допустимая в constexpr
+constexpr bool IsConstantEvaluated() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+}
+
+// Тип можно хранить в обычном массиве, пригодном для constexpr: элементы за пределами
+// размера живут всегда, поэтому создание должно быть дешёвым, а копирование и уничтожение тривиальными
+template <typename T>
+inline constexpr bool is_static_array_storable_v = std::is_trivially_copyable_v<T>
+    && std::is_trivially_destructible_v<T> && std::is_nothrow_default_constructible_v<T>;
+
+// Хранилище StaticVector. Подходящие типы лежат в массиве элементов (цена — инициализация
+// массива при создании), остальные — в сырой памяти. Деструктор есть только у хранилища
+// нетривиально уничтожаемых типов, поэтому контейнер тривиально уничтожаем вместе с T
+template <typename T, size_t N, bool = is_static_array_storable_v<T>, bool = std::is_trivially_destructible_v<T>>
+struct StaticStorage {
+    constexpr T* Data() noexcept {
+        return elements;
+    }
+    constexpr const T* Data() const noexcept {
+        return elements;
+    }
+
+    T elements[N] = {};
+    size_t size = 0;
+};
+
+template <typename T, size_t N>
+struct StaticStorage<T, N, false, true> {
+    T* Data() noexcept {
+        return std::launder(reinterpret_cast<T*>(bytes));
+    }
+    const T* Data() const noexcept {
+        return std::launder(reinterpret_cast<const T*>(bytes));
+    }
+
+    alignas(T) unsigned char bytes[N * sizeof(T)];
+    size_t size = 0;
+};
+
+template <typename T, size_t N>
+struct StaticStorage<T, N, false, false> : StaticStorage<T, N, false, true> {
+    StaticStorage() = default;
+    StaticStorage(const StaticStorage&) = delete;
+    StaticStorage& operator=(const StaticStorage&) = delete;
+
+    ~StaticStorage() {
+        std::destroy_n(this->Data(), this->size);
+    }
+};
+
+}  // namespace vector_detail
+
+// Вектор на N элементов во встроенном буфере, никогда не обращающийся к куче.
+// Переполнение — нарушение предусловия (assert); TryEmplaceBack сообщает о нём
+// возвратом nullptr. Для тривиально копируемых литеральных T все операции constexpr, поэтому таблицы
+// можно строить на этапе компиляции:
+//   constexpr auto TABLE = [] { StaticVector<int, 8> v; v.PushBack(1); return v; }();
+template <typename T, size_t N>
+class StaticVector {
+    static_assert(N > 0, "Capacity must be positive");
+
+    // Элементы хранятся в массиве: все N объектов живые, операции constexpr
+    static constexpr bool ARRAY_STORAGE = vector_detail::is_static_array_storable_v<T>;
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    constexpr iterator begin() noexcept {
+        return storage_.Data();
+    }
+    constexpr iterator end() noexcept {
+        return storage_.Data() + storage_.size;
+    }
+    constexpr const_iterator begin() const noexcept {
+        return storage_.Data();
+    }
+    constexpr const_iterator end() const noexcept {
+        return storage_.Data() + storage_.size;
+    }
+    constexpr const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    constexpr const_iterator cend() const noexcept {
+        return end();
+    }
+
+    constexpr StaticVector() noexcept = default;
+
+    constexpr explicit StaticVector(size_t size) {
+        Resize(size);
+    }
+
+    constexpr StaticVector(std::initializer_list<T> values) {
+        assert(values.size() <= N);
+        for (const T& value : values) {
+            EmplaceBack(value);
+        }
+    }
+
+    constexpr StaticVector(const StaticVector& other) {
+        if constexpr (ARRAY_STORAGE) {
+            for (size_t i = 0; i < other.Size(); ++i) {
+                storage_.elements[i] = other[i];
+            }
+        } else {
+            std::uninitialized_copy_n(other.begin(), other.Size(), begin());
+        }
+        storage_.size = other.Size();
+    }
+
+    // Элементы перемещаются по одному, источник сохраняет свой размер
+    constexpr StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if constexpr (ARRAY_STORAGE) {
+            for (size_t i = 0; i < other.Size(); ++i) {
+                storage_.elements[i] = other[i];
+            }
+        } else {
+            std::uninitialized_move_n(other.begin(), other.Size(), begin());
+        }
+        storage_.size = other.Size();
+    }
+
+    constexpr StaticVector& operator=(const StaticVector& rhs) {
+        if (this != &rhs) {
+            Assign(rhs.begin(), rhs.Size());
+        }
+        return *this;
+    }
+
+    constexpr StaticVector& operator=(StaticVector&& rhs) noexcept(std::is_nothrow_move_assignable_v<T>
+                                                                   && std::is_nothrow_move_constructible_v<T>) {
+        if (this != &rhs) {
+            Assign(std::make_move_iterator(rhs.begin()), rhs.Size());
+        }
+        return *this;
+    }
+
+    [[nodiscard]] constexpr size_t Size() const noexcept {
+        return storage_.size;
+    }
+
+    [[nodiscard]] static constexpr size_t Capacity() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] constexpr bool Full() const noexcept {
+        return storage_.size == N;
+    }
+
+    constexpr const T& operator[](size_t index) const noexcept {
+        assert(index < storage_.size);
+        return storage_.Data()[index];
+    }
+
+    constexpr T& operator[](size_t index) noexcept {
+        assert(index < storage_.size);
+        return storage_.Data()[index];
+    }
+
+    constexpr void Resize(size_t new_size) {
+        assert(new_size <= N);
+        while (storage_.size < new_size) {
+            EmplaceBack();
+        }
+        Truncate(new_size);
+    }
+
+    constexpr void Clear() noexcept {
+        Truncate(0);
+    }
+
+    constexpr void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    constexpr void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args>
+    constexpr T& EmplaceBack(Args&&... args) {
+        assert(!Full());
+        ConstructAt(storage_.size, std::forward<Args>(args)...);
+        return storage_.Data()[storage_.size++];
+    }
+
+    // nullptr, если места нет: переполнение из внешних данных не обязано быть ошибкой программы
+    template <typename... Args>
+    constexpr T* TryEmplaceBack(Args&&... args) {
+        return Full() ? nullptr : &EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    constexpr void PopBack() noexcept {
+        assert(storage_.size > 0);
+        Truncate(storage_.size - 1);
+    }
+
+    template <typename... Args>
+    constexpr iterator Emplace(const_iterator pos, Args&&... args) {
+        assert(!Full());
+        const size_t index = pos - cbegin();
+        if constexpr (ARRAY_STORAGE) {
+            if (vector_detail::IsConstantEvaluated()) {
+                T temp_obj(std::forward<Args>(args)...);
+                for (size_t i = storage_.size; i > index; --i) {
+                    storage_.elements[i] = storage_.elements[i - 1];
+                }
+                storage_.elements[index] = temp_obj;
+                ++storage_.size;
+                return begin() + index;
+            }
+        }
+        vector_detail::EmplaceShifted(storage_.Data(), storage_.size, index, std::forward<Args>(args)...);
+        ++storage_.size;
+        return begin() + index;
+    }
+
+    constexpr iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    constexpr iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    constexpr iterator Erase(const_iterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    constexpr iterator Erase(const_iterator first, const_iterator last) {
+        assert(cbegin() <= first && first <= last && last <= cend());
+        const size_t index = first - cbegin();
+        const size_t count = last - first;
+        if constexpr (ARRAY_STORAGE) {
+            if (vector_detail::IsConstantEvaluated()) {
+                for (size_t i = index; i + count < storage_.size; ++i) {
+                    storage_.elements[i] = storage_.elements[i + count];
+                }
+                storage_.size -= count;
+                return begin() + index;
+            }
+        }
+        vector_detail::EraseShifted(storage_.Data(), storage_.size, index, count);
+        storage_.size -= count;
+        return begin() + index;
+    }
+
+private:
+    template <typename... Args>
+    constexpr void ConstructAt(size_t index, Args&&... args) {
+        if constexpr (ARRAY_STORAGE) {
+            storage_.elements[index] = T(std::forward<Args>(args)...);
+        } else {
+            new (storage_.Data() + index) T(std::forward<Args>(args)...);
+        }
+    }
+
+    constexpr void Truncate(size_t new_size) noexcept {
+        if (new_size < storage_.size) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                std::destroy(begin() + new_size, end());
+            }
+            storage_.size = new_size;
+        }
+    }
+
+    // Присваивает живым элементам и достраивает или уничтожает остаток
+    template <typename InputIt>
+    constexpr void Assign(InputIt source, size_t count) {
+        const size_t common = std::min(storage_.size, count);
+        for (size_t i = 0; i < common; ++i, ++source) {
+            storage_.Data()[i] = *source;
+        }
+        for (size_t i = common; i < count; ++i, ++source) {
+            EmplaceBack(*source);
+        }
+        Truncate(count);
+    }
+
+    vector_detail::StaticStorage<T, N> storage_;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+// С -DVECTOR_USE_JEMALLOC размер блока и рост на месте берутся у jemalloc (sallocx, xallocx)
+#if defined(VECTOR_USE_JEMALLOC)
+#include <jemalloc/jemalloc.h>
+#elif defined(__linux__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+
+// Аллокатор на malloc, который отдаёт вектору запас своих классов размеров:
+// allocate_at_least возвращает реальную ёмкость блока (malloc_usable_size, malloc_size,
+// sallocx), а expand растит блок на месте через xallocx. Без jemalloc expand лишь
+// сообщает реальный размер блока, поэтому растёт на месте только в пределах запаса.
+// Подключается параметром Alloc: Vector<int, UsableSizeAllocator<int>>
+template <typename T>
+class UsableSizeAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "UsableSizeAllocator does not support over-aligned types");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = UsableSizeAllocator<U>;
+    };
+
+    // Аналог std::allocation_result из C++23
+    struct allocation_result {
+        T* ptr;
+        size_t count;
+    };
+
+    UsableSizeAllocator() noexcept = default;
+
+    template <typename U>
+    UsableSizeAllocator(const UsableSizeAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        void* ptr = std::malloc(n * sizeof(T));
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    allocation_result allocate_at_least(size_t n) {
+        T* ptr = allocate(n);
+        return {ptr, UsableCount(ptr, n)};
+    }
+
+    void deallocate(T* p, size_t /*n*/) noexcept {
+        std::free(p);
+    }
+
+    size_t expand([[maybe_unused]] T* p, size_t n, [[maybe_unused]] size_t new_n) noexcept {
+#if defined(VECTOR_USE_JEMALLOC)
+        if (new_n > SIZE_MAX / sizeof(T)) {
+            return n;
+        }
+        return xallocx(static_cast<void*>(p), new_n * sizeof(T), 0, 0) / sizeof(T);
+#else
+        return UsableCount(p, n);
+#endif
+    }
+
+    bool operator==(const UsableSizeAllocator&) const noexcept {
+        return true;
+    }
+
+    bool operator!=(const UsableSizeAllocator&) const noexcept {
+        return false;
+    }
+
+private:
+    // Реальная ёмкость блока, выделенного под n элементов
+    static size_t UsableCount([[maybe_unused]] T* p, [[maybe_unused]] size_t n) noexcept {
+#if defined(VECTOR_USE_JEMALLOC)
+        return sallocx(static_cast<void*>(p), 0) / sizeof(T);
+#elif defined(__linux__)
+        return malloc_usable_size(static_cast<void*>(p)) / sizeof(T);
+#elif defined(__APPLE__)
+        return malloc_size(static_cast<const void*>(p)) / sizeof(T);
+#else
+        return n;
+#endif
+    }
+};
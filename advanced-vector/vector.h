@@ -2,33 +2,314 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <new>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <memory>
 #include <algorithm>
+#include <initializer_list>
+#include <iterator>
 
+// Тип можно перемещать побайтовым копированием без вызова деструктора у источника.
+// Специализируйте для своих типов (например, владеющих дескрипторов вроде unique_ptr)
 template <typename T>
-class RawMemory {
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Аллокатор умеет расширять блок на месте: Alloc::reallocate(p, old_n, new_n)
+// переносит содержимое побайтово (realloc, mremap)
+template <typename Alloc, typename = void>
+struct allocator_has_reallocate : std::false_type {};
+
+template <typename Alloc>
+struct allocator_has_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(
+    std::declval<typename std::allocator_traits<Alloc>::pointer>(), size_t{}, size_t{}))>> : std::true_type {};
+
+template <typename Alloc>
+inline constexpr bool allocator_has_reallocate_v = allocator_has_reallocate<Alloc>::value;
+
+// Аллокатор сообщает реальный размер блока: Alloc::allocate_at_least(n) возвращает
+// {ptr, count} с count >= n (как std::allocator_traits::allocate_at_least в C++23).
+// RawMemory принимает count за ёмкость, и запас аллокатора не пропадает
+template <typename Alloc, typename = void>
+struct allocator_has_allocate_at_least : std::false_type {};
+
+template <typename Alloc>
+struct allocator_has_allocate_at_least<Alloc, std::void_t<decltype(std::declval<Alloc&>().allocate_at_least(size_t{}).ptr),
+                                                         decltype(std::declval<Alloc&>().allocate_at_least(size_t{}).count)>>
+    : std::true_type {};
+
+template <typename Alloc>
+inline constexpr bool allocator_has_allocate_at_least_v = allocator_has_allocate_at_least<Alloc>::value;
+
+// Аллокатор умеет расти без переноса: Alloc::expand(p, n, new_n) noexcept пытается увеличить
+// блок на месте (как xallocx) и возвращает его новый размер в элементах, не меньше n
+template <typename Alloc, typename = void>
+struct allocator_has_expand : std::false_type {};
+
+template <typename Alloc>
+struct allocator_has_expand<Alloc, std::void_t<decltype(std::declval<Alloc&>().expand(
+    std::declval<typename std::allocator_traits<Alloc>::pointer>(), size_t{}, size_t{}))>> : std::true_type {};
+
+template <typename Alloc>
+inline constexpr bool allocator_has_expand_v = allocator_has_expand<Alloc>::value;
+
+// Аллокатор сам распределяет параллельную работу над своими буферами:
+// Alloc::parallel_chunks(count, action, rollback) с контрактом vector_detail::ParallelChunks.
+// Через него идут конструирование, копирование и уничтожение с parallel_tag, поэтому
+// аллокатор может выполнять первое касание страниц потоками нужных узлов NUMA
+template <typename Alloc, typename = void>
+struct allocator_has_parallel_chunks : std::false_type {};
+
+template <typename Alloc>
+struct allocator_has_parallel_chunks<Alloc, std::void_t<decltype(std::declval<const Alloc&>().parallel_chunks(
+    size_t{}, std::declval<void (*)(size_t, size_t)>(), std::declval<void (*)(size_t, size_t)>()))>>
+    : std::true_type {};
+
+template <typename Alloc>
+inline constexpr bool allocator_has_parallel_chunks_v = allocator_has_parallel_chunks<Alloc>::value;
+
+// Операции над сырыми буферами, общие для контейнеров на основе RawMemory
+namespace vector_detail {
+
+// Побайтовый перенос для is_trivially_relocatable_v<T>; диапазоны могут перекрываться
+template <typename T>
+void Relocate(T* from, size_t n, T* to) noexcept {
+    if (n != 0) {
+        std::memmove(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(T));
+    }
+}
+
+template <typename T>
+void UninitializedMoveOrCopyN(T* from, size_t n, T* to) {
+    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        std::uninitialized_move_n(from, n, to);
+    } else {
+        std::uninitialized_copy_n(from, n, to);
+    }
+}
+
+// Переносит size элементов from в to вокруг уже созданных там [index, index + count).
+// Если T не тривиально перемещаем, исходные элементы остаются живыми (перемещёнными или
+// скопированными) и их уничтожает вызывающий. При исключении to снова содержит только
+// вставленные элементы
+template <typename T>
+void MoveAround(T* from, size_t size, T* to, size_t index, size_t count) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        Relocate(from, index, to);
+        Relocate(from + index, size - index, to + index + count);
+    } else {
+        UninitializedMoveOrCopyN(from, index, to);
+        try {
+            UninitializedMoveOrCopyN(from + index, size - index, to + index + count);
+        } catch (...) {
+            std::destroy_n(to, index);
+            throw;
+        }
+    }
+}
+
+// То же, но исходные элементы разрушаются
+template <typename T>
+void RelocateAround(T* from, size_t size, T* to, size_t index, size_t count) {
+    MoveAround(from, size, to, index, count);
+    if constexpr (!is_trivially_relocatable_v<T>) {
+        std::destroy_n(from, size);
+    }
+}
+
+// Создаёт элемент на позиции index среди size живых элементов data,
+// за которыми есть место ещё под один
+template <typename T, typename... Args>
+void EmplaceShifted(T* data, size_t size, size_t index, Args&&... args) {
+    if (size == index) {
+        new (data + size) T(std::forward<Args>(args)...);
+    } else if constexpr (is_trivially_relocatable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+        T temp_obj(std::forward<Args>(args)...);
+        Relocate(data + index, size - index, data + index + 1);
+        new (data + index) T(std::move(temp_obj));
+    } else {
+        T temp_obj(std::forward<Args>(args)...);
+        new (data + size) T(std::move(data[size - 1]));
+        std::move_backward(data + index, data + size - 1, data + size);
+        data[index] = std::move(temp_obj);
+    }
+}
+
+// Удаляет [index, index + count) из size живых элементов data, сдвигая хвост
+template <typename T>
+void EraseShifted(T* data, size_t size, size_t index, size_t count) {
+    // Пустой диапазон: сдвиг хвоста на ноль переместил бы каждый элемент сам в себя
+    if (count == 0) {
+        return;
+    }
+    if constexpr (is_trivially_relocatable_v<T>) {
+        std::destroy_n(data + index, count);
+        Relocate(data + index + count, size - index - count, data + index);
+    } else {
+        std::move(data + index + count, data + size, data + index);
+        std::destroy_n(data + size - count, count);
+    }
+}
+
+// Меньше стольких элементов на поток распараллеливание не окупается
+inline constexpr size_t PARALLEL_MIN_CHUNK = size_t{1} << 14;
+
+// Число частей, на которые параллельные алгоритмы делят count элементов
+inline size_t ParallelChunkCount(size_t count) noexcept {
+    const size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    return std::clamp<size_t>(count / PARALLEL_MIN_CHUNK, 1, hardware);
+}
+
+// Начало части chunk из chunks почти равных частей [0, count)
+inline size_t ChunkBound(size_t count, size_t chunks, size_t chunk) noexcept {
+    return count / chunks * chunk + std::min(chunk, count % chunks);
+}
+
+// Выполняет action(chunk, first, last) для частей [bound(chunk), bound(chunk + 1)), каждую
+// в своём потоке (часть 0 — в текущем). Если какая-то часть бросила исключение, для успешных
+// частей вызывается rollback(first, last), а исключение первой неудачной части пробрасывается
+// дальше. Если потоки недоступны, части выполняются в текущем потоке
+template <typename Bound, typename Action, typename Rollback>
+void ParallelChunksOn(size_t chunks, Bound bound, Action action, Rollback rollback) {
+    if (chunks == 1) {
+        action(size_t{0}, bound(size_t{0}), bound(size_t{1}));
+        return;
+    }
+
+    std::unique_ptr<std::exception_ptr[]> errors;
+    std::unique_ptr<std::thread[]> threads;
+    try {
+        errors = std::make_unique<std::exception_ptr[]>(chunks);
+        threads = std::make_unique<std::thread[]>(chunks);
+    } catch (const std::bad_alloc&) {
+        std::exception_ptr error;
+        size_t done = 0;
+        for (; done < chunks && error == nullptr; ++done) {
+            try {
+                action(done, bound(done), bound(done + 1));
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        if (error != nullptr) {
+            for (size_t chunk = 0; chunk + 1 < done; ++chunk) {
+                rollback(bound(chunk), bound(chunk + 1));
+            }
+            std::rethrow_exception(error);
+        }
+        return;
+    }
+    auto run = [&](size_t chunk) noexcept {
+        try {
+            action(chunk, bound(chunk), bound(chunk + 1));
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        try {
+            threads[chunk] = std::thread(run, chunk);
+        } catch (...) {
+            run(chunk);
+        }
+    }
+    run(0);
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        if (threads[chunk].joinable()) {
+            threads[chunk].join();
+        }
+    }
+
+    const auto failed = std::find_if(errors.get(), errors.get() + chunks, [](const std::exception_ptr& error) {
+        return error != nullptr;
+    });
+    if (failed == errors.get() + chunks) {
+        return;
+    }
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        if (errors[chunk] == nullptr) {
+            rollback(bound(chunk), bound(chunk + 1));
+        }
+    }
+    std::rethrow_exception(*failed);
+}
+
+// Делит [0, count) на части по числу ядер и выполняет action(first, last) для каждой
+// в своём потоке, как ParallelChunksOn
+template <typename Action, typename Rollback>
+void ParallelChunks(size_t count, Action action, Rollback rollback) {
+    const size_t chunks = ParallelChunkCount(count);
+    ParallelChunksOn(
+        chunks,
+        [count, chunks](size_t chunk) {
+            return ChunkBound(count, chunks, chunk);
+        },
+        [&action](size_t /*chunk*/, size_t first, size_t last) {
+            action(first, last);
+        },
+        rollback);
+}
+
+}  // namespace vector_detail
+
+template <typename T, typename Alloc = std::allocator<T>>
+class RawMemory : private Alloc {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>, "Alloc::value_type must be T");
+
 public:
+    using allocator_type = Alloc;
+
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
-        : buffer_(Allocate(capacity))
-        , capacity_(capacity)
+    explicit RawMemory(const Alloc& alloc) noexcept
+        : Alloc(alloc)
     {}
 
+    // Ёмкость может оказаться больше запрошенной, если аллокатор поддерживает allocate_at_least
+    explicit RawMemory(size_t capacity, const Alloc& alloc = Alloc())
+        : Alloc(alloc)
+    {
+        if constexpr (allocator_has_allocate_at_least_v<Alloc>) {
+            if (capacity != 0) {
+                const auto result = GetAllocatorRef().allocate_at_least(capacity);
+                assert(result.count >= capacity);
+                buffer_ = result.ptr;
+                capacity_ = result.count;
+            }
+        } else {
+            buffer_ = Allocate(capacity);
+            capacity_ = capacity;
+        }
+    }
+
     RawMemory(RawMemory&& other) noexcept
-        : buffer_(std::move(other.buffer_))
+        : Alloc(std::move(other.GetAllocatorRef()))
+        , buffer_(std::move(other.buffer_))
         , capacity_(other.capacity_)
     {
         other.buffer_ = nullptr;
         other.capacity_ = 0;
     }
 
+    // Аллокатор переходит вместе с буфером только при propagate_on_container_move_assignment,
+    // иначе аллокаторы обязаны быть равны (это проверяет Vector)
     RawMemory& operator=(RawMemory&& rhs) noexcept {
         if (this != & rhs) {
-            Deallocate(buffer_);
+            Deallocate(buffer_, capacity_);
 
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                GetAllocatorRef() = std::move(rhs.GetAllocatorRef());
+            } else {
+                assert(GetAllocatorRef() == rhs.GetAllocatorRef());
+            }
             buffer_ = std::move(rhs.buffer_);
             capacity_ = rhs.capacity_;
 
@@ -42,7 +323,7 @@ public:
     RawMemory& operator=(const RawMemory&) = delete;
 
     ~RawMemory() {
-        Deallocate(buffer_);
+        Deallocate(buffer_, capacity_);
     }
 
     T* operator+(size_t offset) noexcept {
@@ -64,10 +345,44 @@ public:
     }
 
     void Swap(RawMemory& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(GetAllocatorRef(), other.GetAllocatorRef());
+        } else {
+            assert(GetAllocatorRef() == other.GetAllocatorRef());
+        }
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
     }
 
+    // Меняет ёмкость, перенося содержимое побайтово средствами аллокатора
+    void Reallocate(size_t new_capacity) {
+        buffer_ = GetAllocatorRef().reallocate(buffer_, capacity_, new_capacity);
+        capacity_ = new_capacity;
+    }
+
+    // Пытается увеличить ёмкость до new_capacity, не перемещая буфер.
+    // Без Alloc::expand всегда возвращает false
+    bool TryExpand([[maybe_unused]] size_t new_capacity) noexcept {
+        if constexpr (allocator_has_expand_v<Alloc>) {
+            if (buffer_ != nullptr && new_capacity > capacity_) {
+                // Даже неудачная попытка могла увеличить блок
+                capacity_ = std::max(capacity_, GetAllocatorRef().expand(buffer_, capacity_, new_capacity));
+                return capacity_ >= new_capacity;
+            }
+        }
+        return false;
+    }
+
+    // Освобождает буфер и принимает новый аллокатор
+    // (нужно для propagate_on_container_copy_assignment)
+    void Reset(const Alloc& alloc) noexcept {
+        Deallocate(buffer_, capacity_);
+        buffer_ = nullptr;
+        capacity_ = 0;
+        GetAllocatorRef() = alloc;
+    }
+
     const T* GetAddress() const noexcept {
         return buffer_;
     }
@@ -80,24 +395,125 @@ public:
         return capacity_;
     }
 
+    [[nodiscard]] Alloc GetAllocator() const noexcept {
+        return GetAllocatorRef();
+    }
+
 private:
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    Alloc& GetAllocatorRef() noexcept {
+        return *this;
+    }
+
+    const Alloc& GetAllocatorRef() const noexcept {
+        return *this;
     }
 
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    T* Allocate(size_t n) {
+        return n != 0 ? AllocTraits::allocate(GetAllocatorRef(), n) : nullptr;
+    }
+
+    void Deallocate(T* buf, size_t n) noexcept {
+        if (buf != nullptr) {
+            AllocTraits::deallocate(GetAllocatorRef(), buf, n);
+        }
     }
 
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
 };
 
-template <typename T>
+// Политики роста: NextCapacity(size, element_size) возвращает ёмкость больше size,
+// которую получит вектор при переполнении
+
+// Удвоение, начиная с одного элемента
+struct DoublingGrowth {
+    static size_t NextCapacity(size_t size, size_t /*element_size*/) noexcept {
+        return size == 0 ? 1 : size * 2;
+    }
+};
+
+// Рост в Numerator/Denominator раз. Первое выделение занимает не меньше MinBytes байт.
+// При множителе меньше золотого сечения (например, 3/2) освобождённые ранее блоки
+// в сумме со временем вмещают следующий, и аллокатор может их переиспользовать
+template <size_t Numerator = 3, size_t Denominator = 2, size_t MinBytes = 64>
+struct GeometricGrowth {
+    static_assert(Numerator > Denominator && Denominator > 0, "Growth factor must be greater than 1");
+
+    static size_t NextCapacity(size_t size, size_t element_size) noexcept {
+        const size_t min_capacity = std::max<size_t>((MinBytes + element_size - 1) / element_size, 1);
+        return std::max({size / Denominator * Numerator + size % Denominator * Numerator / Denominator,
+                         size + 1, min_capacity});
+    }
+};
+
+// Округляет ёмкость Base до класса размера аллокатора: степени двойки до страницы
+// и целого числа страниц начиная с неё
+template <typename Base = GeometricGrowth<>, size_t PageSize = 4096>
+struct SizeClassGrowth {
+    static_assert((PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+    static size_t NextCapacity(size_t size, size_t element_size) noexcept {
+        const size_t bytes = Base::NextCapacity(size, element_size) * element_size;
+        size_t rounded = PageSize;
+        if (bytes < PageSize) {
+            while (rounded / 2 >= bytes) {
+                rounded /= 2;
+            }
+        } else {
+            rounded = (bytes + PageSize - 1) / PageSize * PageSize;
+        }
+        return rounded / element_size;
+    }
+};
+
+// Метка конструирования элементов по умолчанию (default-initialization) вместо
+// value-initialization: тривиальные типы остаются неинициализированными
+struct DefaultInitTag {
+    explicit DefaultInitTag() = default;
+};
+
+inline constexpr DefaultInitTag default_init_tag{};
+
+// Метка, распараллеливающая массовое конструирование, копирование и уничтожение
+// элементов между потоками. Окупается на векторах из миллионов элементов
+struct ParallelTag {
+    explicit ParallelTag() = default;
+};
+
+inline constexpr ParallelTag parallel_tag{};
+
+// Политика инструментирования без накладных расходов: все хуки пусты.
+// Собирающая статистику политика TaggedStats объявлена в vector_stats.h
+struct NoStats {
+    static void OnAllocation(size_t /*bytes*/) noexcept {}
+    static void OnReallocation() noexcept {}
+    static void OnMoved(size_t /*count*/) noexcept {}
+    static void OnCopied(size_t /*count*/) noexcept {}
+    static void OnRelocated(size_t /*count*/) noexcept {}
+    static void OnCapacity(size_t /*capacity*/) noexcept {}
+};
+
+// Политики освобождения: Retire(buffer, size) забирает буфер, в начале которого
+// size живых элементов, уничтожает их и освобождает память. Через политику проходят
+// буферы, которые освобождают ~Vector, присваивание перемещением и копированием, рост
+// при вставке, Reserve и ShrinkToFit. Откладывающие политики объявлены в vector_reclaim.h.
+// Блок, который аллокатор растит на месте (reallocate), освобождает сам аллокатор
+struct ImmediateReclaim {
+    template <typename T, typename Alloc>
+    static void Retire(RawMemory<T, Alloc> buffer, size_t size) noexcept {
+        std::destroy_n(buffer.GetAddress(), size);
+    }
+};
+
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = DoublingGrowth, typename Stats = NoStats,
+          typename Reclaim = ImmediateReclaim>
 class Vector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
 public:
     using iterator = T*;
     using const_iterator = const T*;
+    using allocator_type = Alloc;
 
     iterator begin() noexcept {
         return data_.GetAddress();
@@ -120,18 +536,72 @@ public:
 
     Vector() = default;
 
-    explicit Vector(size_t size)
-        : data_(size)
+    explicit Vector(const Alloc& alloc) noexcept
+        : data_(alloc)
+    {}
+
+    explicit Vector(size_t size, const Alloc& alloc = Alloc())
+        : data_(AllocateBuffer(size, alloc))
         , size_(size)
     {
         std::uninitialized_value_construct_n(data_.GetAddress(), size_);
     }
 
+    Vector(size_t size, DefaultInitTag, const Alloc& alloc = Alloc())
+        : data_(AllocateBuffer(size, alloc))
+        , size_(size)
+    {
+        std::uninitialized_default_construct_n(data_.GetAddress(), size_);
+    }
+
+    // Как Vector(size), но элементы конструируются параллельно. Если конструктор
+    // элемента бросит исключение, уже созданные элементы всех потоков уничтожаются
+    Vector(ParallelTag, size_t size, const Alloc& alloc = Alloc())
+        : data_(AllocateBuffer(size, alloc))
+        , size_(size)
+    {
+        T* data = data_.GetAddress();
+        ParallelChunks(
+            size_,
+            [data](size_t first, size_t last) {
+                std::uninitialized_value_construct(data + first, data + last);
+            },
+            [data](size_t first, size_t last) {
+                std::destroy(data + first, data + last);
+            });
+    }
+
     Vector(const Vector& other)
-        : data_(other.size_)
+        : Vector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {}
+
+    Vector(ParallelTag, const Vector& other)
+        : Vector(parallel_tag, other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {}
+
+    Vector(ParallelTag, const Vector& other, const Alloc& alloc)
+        : data_(AllocateBuffer(other.size_, alloc))
+        , size_(other.size_)
+    {
+        T* data = data_.GetAddress();
+        const T* source = other.data_.GetAddress();
+        ParallelChunks(
+            size_,
+            [data, source](size_t first, size_t last) {
+                std::uninitialized_copy(source + first, source + last, data + first);
+            },
+            [data](size_t first, size_t last) {
+                std::destroy(data + first, data + last);
+            });
+        Stats::OnCopied(size_);
+    }
+
+    Vector(const Vector& other, const Alloc& alloc)
+        : data_(AllocateBuffer(other.size_, alloc))
         , size_(other.size_)
     {
         std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
+        Stats::OnCopied(size_);
     }
 
     Vector(Vector&& other) noexcept
@@ -141,10 +611,27 @@ public:
         other.size_ = 0;
     }
 
+    Vector(Vector&& other, const Alloc& alloc)
+        : data_(alloc)
+    {
+        if (alloc == other.GetAllocator()) {
+            data_.Swap(other.data_);
+            std::swap(size_, other.size_);
+        } else {
+            MoveElementsFrom(other);
+        }
+    }
+
     Vector& operator=(const Vector& rhs) {
         if (this != &rhs) {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                if (GetAllocator() != rhs.GetAllocator()) {
+                    Reclaim::Retire(std::move(data_), std::exchange(size_, 0));
+                    data_.Reset(rhs.GetAllocator());
+                }
+            }
             if (rhs.size_ > Capacity()) {
-                Vector rhs_copy(rhs);
+                Vector rhs_copy(rhs, GetAllocator());
                 Swap(rhs_copy);
             } else {
                 size_t count_to_copy = std::min(size_, rhs.size_);
@@ -161,8 +648,19 @@ public:
         return *this;
     }
 
-    Vector& operator=(Vector&& rhs) noexcept {
+    Vector& operator=(Vector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                             || AllocTraits::is_always_equal::value) {
         if (this != &rhs) {
+            if constexpr (!AllocTraits::propagate_on_container_move_assignment::value
+                          && !AllocTraits::is_always_equal::value) {
+                if (GetAllocator() != rhs.GetAllocator()) {
+                    Vector tmp(GetAllocator());
+                    tmp.MoveElementsFrom(rhs);
+                    Swap(tmp);
+                    return *this;
+                }
+            }
+            Reclaim::Retire(std::move(data_), size_);
             data_ = std::move(rhs.data_);
             size_ = rhs.size_;
 
@@ -172,7 +670,7 @@ public:
     }
 
     ~Vector() {
-        std::destroy_n(data_.GetAddress(), size_);
+        Reclaim::Retire(std::move(data_), size_);
     }
 
     [[nodiscard]] size_t Size() const noexcept {
@@ -183,6 +681,10 @@ public:
         return data_.Capacity();
     }
 
+    [[nodiscard]] Alloc GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
     const T& operator[](size_t index) const noexcept {
         return const_cast<Vector&>(*this)[index];
     }
@@ -196,15 +698,46 @@ public:
         if (new_capacity <= Capacity()) {
             return;
         }
-        RawMemory<T> new_data(new_capacity);
+        ChangeCapacity(new_capacity);
+    }
 
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
-        } else {
-            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+    // Переносит элементы в буфер ровно под Size() элементов
+    void ShrinkToFit() {
+        if (size_ < Capacity()) {
+            ChangeCapacity(size_);
         }
+    }
+
+    // Удаляет все элементы, сохраняя ёмкость
+    void Clear() noexcept {
         std::destroy_n(data_.GetAddress(), size_);
-        data_.Swap(new_data);
+        size_ = 0;
+    }
+
+    // Уничтожает элементы параллельно. Для больших векторов вызывайте перед
+    // разрушением вместо неявного последовательного уничтожения в ~Vector
+    void Clear(ParallelTag) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            T* data = data_.GetAddress();
+            ParallelChunks(
+                size_,
+                [data](size_t first, size_t last) noexcept {
+                    std::destroy(data + first, data + last);
+                },
+                [](size_t, size_t) noexcept {});
+        }
+        size_ = 0;
+    }
+
+    // Параллельное копирующее присваивание со строгой гарантией: копия строится
+    // в новом буфере и только затем занимает место старого содержимого
+    void Assign(ParallelTag, const Vector& rhs) {
+        if (this != &rhs) {
+            const bool propagate = AllocTraits::propagate_on_container_copy_assignment::value;
+            Vector rhs_copy(parallel_tag, rhs, propagate ? rhs.GetAllocator() : GetAllocator());
+            Clear(parallel_tag);
+            *this = std::move(rhs_copy);
+        }
     }
 
     void Swap(Vector& other) noexcept {
@@ -222,6 +755,28 @@ public:
         size_ = new_size;
     }
 
+    void ResizeDefaultInit(size_t new_size) {
+        if (new_size < size_) {
+            std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
+        } else {
+            Reserve(new_size);
+            std::uninitialized_default_construct_n(data_.GetAddress() + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    // Добавляет count неинициализированных элементов и возвращает указатель на первый из них
+    T* AppendUninitialized(size_t count) {
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                      "AppendUninitialized requires a trivial element type");
+        if (size_ + count > Capacity()) {
+            Reserve(GrowthCapacity(size_ + count));
+        }
+        T* tail = data_.GetAddress() + size_;
+        size_ += count;
+        return tail;
+    }
+
     void PushBack(const T& value) {
         EmplaceBack(value);
     }
@@ -235,10 +790,79 @@ public:
         --size_;
     }
 
+    // Удаляет count последних элементов
+    void PopBack(size_t count) noexcept {
+        assert(count <= size_);
+        Truncate(size_ - count);
+    }
+
+    // Уменьшает размер до new_size, уничтожая хвост одним destroy_n
+    void Truncate(size_t new_size) noexcept {
+        assert(new_size <= size_);
+        std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
+        size_ = new_size;
+    }
+
+    // Вставка в конец минует общий путь Emplace: есть место — объект создаётся сразу за последним
     template <typename... Args>
     T& EmplaceBack(Args&&... args) {
-        iterator it = Emplace(end(), std::forward<Args>(args)...);
-        return *it;
+        if (size_ != Capacity()) {
+            T* slot = new (data_.GetAddress() + size_) T(std::forward<Args>(args)...);
+            ++size_;
+            return *slot;
+        }
+        return *EmplaceWithReallocation(end(), std::forward<Args>(args)...);
+    }
+
+    // Пакетное добавление с одной проверкой ёмкости: конструктор резервирует место под count
+    // элементов, Emplace только создаёт объект и сдвигает локальный конец, а размер вектора
+    // обновляется в деструкторе. Пока сессия жива, к вектору обращаться нельзя.
+    // Если Emplace бросит исключение, уже добавленные элементы остаются в векторе
+    //   auto session = v.BeginAppend(n);
+    //   for (...) session.Emplace(x);
+    class AppendSession {
+    public:
+        AppendSession(const AppendSession&) = delete;
+        AppendSession& operator=(const AppendSession&) = delete;
+
+        ~AppendSession() {
+            vector_.size_ = end_ - vector_.data_.GetAddress();
+        }
+
+        // Не проверяет ёмкость: добавлять можно не больше зарезервированного
+        template <typename... Args>
+        T& Emplace(Args&&... args) {
+            assert(end_ != limit_);
+            T* slot = new (end_) T(std::forward<Args>(args)...);
+            ++end_;
+            return *slot;
+        }
+
+        // Сколько элементов ещё можно добавить
+        [[nodiscard]] size_t Remaining() const noexcept {
+            return limit_ - end_;
+        }
+
+    private:
+        friend class Vector;
+
+        AppendSession(Vector& vector, size_t count)
+            : vector_(vector)
+        {
+            if (vector.size_ + count > vector.Capacity()) {
+                vector.Reserve(vector.GrowthCapacity(vector.size_ + count));
+            }
+            end_ = vector.data_.GetAddress() + vector.size_;
+            limit_ = end_ + count;
+        }
+
+        Vector& vector_;
+        T* end_ = nullptr;
+        T* limit_ = nullptr;
+    };
+
+    AppendSession BeginAppend(size_t count) {
+        return AppendSession(*this, count);
     }
 
     template <typename... Args>
@@ -256,42 +880,293 @@ public:
         return Emplace(pos, std::move(value));
     }
 
+    iterator Insert(const_iterator pos, size_t count, const T& value) {
+        if (count == 0) {
+            return const_cast<iterator>(pos);
+        }
+        // value может ссылаться на элемент вектора
+        const T value_copy(value);
+        return InsertN(
+            pos, count,
+            [&value_copy](T* dest, size_t /*offset*/, size_t n) {
+                std::uninitialized_fill_n(dest, n, value_copy);
+            },
+            [&value_copy](T* dest, size_t /*offset*/, size_t n) {
+                std::fill_n(dest, n, value_copy);
+            });
+    }
+
+    // Диапазон [first, last) не должен указывать на элементы этого вектора
+    template <typename InputIt,
+              typename = std::enable_if_t<std::is_base_of_v<
+                  std::input_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>>>
+    iterator Insert(const_iterator pos, InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            const auto count = static_cast<size_t>(std::distance(first, last));
+            return InsertN(
+                pos, count,
+                [first](T* dest, size_t offset, size_t n) {
+                    std::uninitialized_copy_n(std::next(first, offset), n, dest);
+                },
+                [first](T* dest, size_t offset, size_t n) {
+                    std::copy_n(std::next(first, offset), n, dest);
+                });
+        } else {
+            // Длина однопроходного диапазона неизвестна, собираем его отдельно
+            Vector buffer(data_.GetAllocator());
+            for (; first != last; ++first) {
+                buffer.EmplaceBack(*first);
+            }
+            return Insert(pos, std::make_move_iterator(buffer.begin()), std::make_move_iterator(buffer.end()));
+        }
+    }
+
+    iterator Insert(const_iterator pos, std::initializer_list<T> values) {
+        return Insert(pos, values.begin(), values.end());
+    }
+
+    template <typename Range>
+    void Append(const Range& range) {
+        using std::begin;
+        using std::end;
+        Insert(cend(), begin(range), end(range));
+    }
+
     iterator Erase(const_iterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    iterator Erase(const_iterator first, const_iterator last) {
+        size_t index = first - data_.GetAddress();
+        size_t count = last - first;
+        if (count == 0) {
+            return data_.GetAddress() + index;
+        }
+
+        vector_detail::EraseShifted(data_.GetAddress(), size_, index, count);
+        size_ -= count;
+
+        return data_.GetAddress() + index;
+    }
+
+    // Удаляет элементы, удовлетворяющие pred, за один проход. Возвращает число удалённых
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        iterator new_end = std::remove_if(begin(), end(), pred);
+        size_t count = end() - new_end;
+        std::destroy_n(new_end, count);
+        size_ -= count;
+        return count;
+    }
+
+    // Удаляет элемент за O(1), ставя на его место последний. Порядок элементов не сохраняется
+    iterator EraseUnordered(const_iterator pos) {
         size_t index = pos - data_.GetAddress();
 
-        std::move(begin() + index + 1, end(), begin() + index);
-        std::destroy_at(end() - 1);
-        --size_;
+        if (index + 1 != size_) {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::destroy_at(begin() + index);
+                vector_detail::Relocate(end() - 1, 1, begin() + index);
+                --size_;
+                return data_.GetAddress() + index;
+            } else {
+                data_[index] = std::move(data_[size_ - 1]);
+            }
+        }
+        PopBack();
 
         return data_.GetAddress() + index;
     }
 
 private:
-    RawMemory<T> data_;
+    static constexpr bool GROWS_IN_PLACE = is_trivially_relocatable_v<T> && allocator_has_reallocate_v<Alloc>;
+
+    RawMemory<T, Alloc> data_;
     size_t size_ = 0;
 
-    template <typename... Args>
-    iterator EmplaceWithReallocation(const_iterator pos, Args&&... args) {
-        size_t index = pos - data_.GetAddress();
-        size_t new_capacity = size_ == 0 ? 1 : size_ * 2;
-        RawMemory<T> new_data(new_capacity);
+    static RawMemory<T, Alloc> AllocateBuffer(size_t capacity, const Alloc& alloc) {
+        RawMemory<T, Alloc> buffer(capacity, alloc);
+        if (capacity != 0) {
+            Stats::OnAllocation(buffer.Capacity() * sizeof(T));
+            Stats::OnCapacity(buffer.Capacity());
+        }
+        return buffer;
+    }
 
-        new (new_data + index) T(std::forward<Args>(args)...);
+    // Параллельная работа над элементами: через аллокатор, если он её распределяет сам
+    template <typename Action, typename Rollback>
+    void ParallelChunks(size_t count, Action action, Rollback rollback) const {
+        if constexpr (allocator_has_parallel_chunks_v<Alloc>) {
+            data_.GetAllocator().parallel_chunks(count, action, rollback);
+        } else {
+            vector_detail::ParallelChunks(count, action, rollback);
+        }
+    }
 
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress(), index, new_data.GetAddress());
+    // Учитывает перенос count элементов в новый буфер тем способом, который выберет MoveAround
+    static void CountTransfer(size_t count) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            Stats::OnRelocated(count);
+        } else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            Stats::OnMoved(count);
         } else {
-            std::uninitialized_copy_n(data_.GetAddress(), index, new_data.GetAddress());
+            Stats::OnCopied(count);
+        }
+    }
+
+    void CountReallocation() const {
+        if (Capacity() != 0) {
+            Stats::OnReallocation();
+            CountTransfer(size_);
         }
+    }
+
+    void ReallocateInPlace(size_t new_capacity) {
+        CountReallocation();
+        data_.Reallocate(new_capacity);
+        if (new_capacity != 0) {
+            Stats::OnAllocation(new_capacity * sizeof(T));
+            Stats::OnCapacity(new_capacity);
+        }
+    }
 
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress() + index, size_ - index, new_data.GetAddress() + index + 1);
+    // Рост без переноса элементов средствами Alloc::expand
+    bool TryExpandInPlace(size_t new_capacity) noexcept {
+        if (data_.TryExpand(new_capacity)) {
+            Stats::OnCapacity(Capacity());
+            return true;
+        }
+        return false;
+    }
+
+    void ChangeCapacity(size_t new_capacity) {
+        if (new_capacity > Capacity() && TryExpandInPlace(new_capacity)) {
+            return;
+        }
+        if constexpr (GROWS_IN_PLACE) {
+            ReallocateInPlace(new_capacity);
+            return;
+        }
+        CountReallocation();
+        RawMemory<T, Alloc> new_data = AllocateBuffer(new_capacity, data_.GetAllocator());
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            vector_detail::Relocate(data_.GetAddress(), size_, new_data.GetAddress());
         } else {
-            std::uninitialized_copy_n(data_.GetAddress() + index, size_ - index, new_data.GetAddress() + index + 1);
+            vector_detail::UninitializedMoveOrCopyN(data_.GetAddress(), size_, new_data.GetAddress());
         }
+        data_.Swap(new_data);
+        // Перемещённые элементы старого буфера уничтожает политика освобождения
+        Reclaim::Retire(std::move(new_data), is_trivially_relocatable_v<T> ? 0 : size_);
+    }
 
-        std::destroy_n(data_.GetAddress(), size_);
+    size_t GrowthCapacity(size_t required_size) const noexcept {
+        return std::max(Growth::NextCapacity(size_, sizeof(T)), required_size);
+    }
+
+    // Вставляет count элементов: construct(dest, offset, n) создаёт в сырой памяти
+    // элементы источника [offset, offset + n), assign(dest, offset, n) присваивает их живым
+    template <typename Construct, typename Assign>
+    iterator InsertN(const_iterator pos, size_t count, Construct construct, Assign assign) {
+        size_t index = pos - data_.GetAddress();
+        if (count == 0) {
+            return data_.GetAddress() + index;
+        }
+
+        if (size_ + count > Capacity() && !TryExpandInPlace(GrowthCapacity(size_ + count))) {
+            size_t new_capacity = GrowthCapacity(size_ + count);
+            if constexpr (GROWS_IN_PLACE) {
+                // Буфер растёт средствами аллокатора, дальше хвост сдвигается как без роста.
+                // Источник вставки не ссылается на элементы вектора, поэтому перенос буфера ему не мешает
+                ReallocateInPlace(new_capacity);
+            } else {
+                CountReallocation();
+                RawMemory<T, Alloc> new_data = AllocateBuffer(new_capacity, data_.GetAllocator());
+
+                construct(new_data + index, 0, count);
+                try {
+                    vector_detail::MoveAround(data_.GetAddress(), size_, new_data.GetAddress(), index, count);
+                } catch (...) {
+                    std::destroy_n(new_data + index, count);
+                    throw;
+                }
+                data_.Swap(new_data);
+                Reclaim::Retire(std::move(new_data), is_trivially_relocatable_v<T> ? 0 : size_);
+                size_ += count;
+                return data_.GetAddress() + index;
+            }
+        }
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            vector_detail::Relocate(begin() + index, size_ - index, begin() + index + count);
+            try {
+                construct(begin() + index, 0, count);
+            } catch (...) {
+                vector_detail::Relocate(begin() + index + count, size_ - index, begin() + index);
+                throw;
+            }
+        } else {
+            const size_t tail = size_ - index;
+            T* old_end = end();
+            if (tail > count) {
+                std::uninitialized_move(old_end - count, old_end, old_end);
+                size_ += count;
+                std::move_backward(begin() + index, old_end - count, old_end);
+                assign(begin() + index, 0, count);
+            } else {
+                construct(old_end, tail, count - tail);
+                size_ += count - tail;
+                std::uninitialized_move(begin() + index, old_end, old_end + (count - tail));
+                size_ += tail;
+                assign(begin() + index, 0, tail);
+            }
+            return data_.GetAddress() + index;
+        }
+
+        size_ += count;
+        return data_.GetAddress() + index;
+    }
+
+    // Поэлементное перемещение из вектора с неравным аллокатором
+    void MoveElementsFrom(Vector& other) {
+        RawMemory<T, Alloc> new_data = AllocateBuffer(other.size_, data_.GetAllocator());
+        std::uninitialized_move_n(other.data_.GetAddress(), other.size_, new_data.GetAddress());
+        Stats::OnMoved(other.size_);
+        data_.Swap(new_data);
+        Reclaim::Retire(std::move(new_data), std::exchange(size_, other.size_));
+    }
+
+    template <typename... Args>
+    iterator EmplaceWithReallocation(const_iterator pos, Args&&... args) {
+        size_t new_capacity = Growth::NextCapacity(size_, sizeof(T));
+        if (TryExpandInPlace(new_capacity)) {
+            return EmplaceWithoutReallocation(pos, std::forward<Args>(args)...);
+        }
+        size_t index = pos - data_.GetAddress();
+
+        if constexpr (GROWS_IN_PLACE && std::is_nothrow_move_constructible_v<T>) {
+            // Аргументы могут ссылаться на элементы вектора, поэтому объект создаётся до переноса
+            T temp_obj(std::forward<Args>(args)...);
+            ReallocateInPlace(new_capacity);
+            vector_detail::Relocate(begin() + index, size_ - index, begin() + index + 1);
+            new (data_ + index) T(std::move(temp_obj));
+            ++size_;
+            return data_.GetAddress() + index;
+        }
+        CountReallocation();
+        RawMemory<T, Alloc> new_data = AllocateBuffer(new_capacity, data_.GetAllocator());
+
+        new (new_data + index) T(std::forward<Args>(args)...);
+        try {
+            vector_detail::MoveAround(data_.GetAddress(), size_, new_data.GetAddress(), index, 1);
+        } catch (...) {
+            std::destroy_at(new_data + index);
+            throw;
+        }
         data_.Swap(new_data);
+        Reclaim::Retire(std::move(new_data), is_trivially_relocatable_v<T> ? 0 : size_);
 
         ++size_;
         return data_.GetAddress() + index;
@@ -301,16 +1176,52 @@ private:
     iterator EmplaceWithoutReallocation(const_iterator pos, Args&&... args) {
         size_t index = pos - data_.GetAddress();
 
-        if (size_ == index) {
-            new (data_ + size_) T(std::forward<Args>(args)...);
-        } else {
-            T temp_obj(std::forward<Args>(args)...);
-            new (data_.GetAddress() + size_) T(std::move(data_[size_ - 1]));
-            std::move_backward(begin() + index, end() - 1, end());
-            data_[index] = std::move(temp_obj);
-        }
+        vector_detail::EmplaceShifted(data_.GetAddress(), size_, index, std::forward<Args>(args)...);
 
         ++size_;
         return data_.GetAddress() + index;
     }
-};
\ No newline at end of file
+};
+
+// Очистка переиспользуемого вектора с возвратом памяти после выбросов:
+// если на протяжении cycles очисток подряд ёмкость превышает ratio размеров,
+// ёмкость уменьшается до наибольшего размера за эти циклы
+class HighWaterMarkPolicy {
+public:
+    HighWaterMarkPolicy(size_t ratio, size_t cycles) noexcept
+        : ratio_(ratio)
+        , cycles_(cycles)
+    {
+        assert(ratio_ > 0 && cycles_ > 0);
+    }
+
+    template <typename Vec>
+    void Clear(Vec& vector) {
+        const size_t size = vector.Size();
+        if (vector.Capacity() > ratio_ * std::max<size_t>(size, 1)) {
+            window_peak_ = std::max(window_peak_, size);
+            ++oversized_cycles_;
+        } else {
+            Reset();
+        }
+        vector.Clear();
+
+        if (oversized_cycles_ >= cycles_) {
+            const size_t new_capacity = window_peak_;
+            Reset();
+            vector.ShrinkToFit();
+            vector.Reserve(new_capacity);
+        }
+    }
+
+private:
+    void Reset() noexcept {
+        oversized_cycles_ = 0;
+        window_peak_ = 0;
+    }
+
+    size_t ratio_;
+    size_t cycles_;
+    size_t oversized_cycles_ = 0;
+    size_t window_peak_ = 0;
+};
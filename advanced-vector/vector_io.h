@@ -0,0 +1,280 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+// Заголовок сериализованного вектора. Данные пишутся в порядке байт текущей машины.
+// В потоковом формате (CHUNKED) после заголовка идут блоки «uint64_t count, count элементов»,
+// завершающиеся блоком с count == 0, а поле size не используется
+struct SerializedVectorHeader {
+    static constexpr uint32_t MAGIC = 0x43455641;  // "AVEC"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t CHUNKED = 1;
+
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint64_t element_size;
+    uint64_t size;
+};
+
+namespace vector_detail {
+
+[[noreturn]] inline void ThrowSystemError(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Пишет все буферы целиком, повторяя writev после частичной записи
+inline void WriteAll(int fd, iovec* iov, int count) {
+    while (count > 0) {
+        const ssize_t written = writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ThrowSystemError("writev");
+        }
+        auto rest = static_cast<size_t>(written);
+        while (count > 0 && rest >= iov->iov_len) {
+            rest -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + rest;
+            iov->iov_len -= rest;
+        }
+    }
+}
+
+inline void WriteAll(int fd, const void* data, size_t bytes) {
+    iovec iov{const_cast<void*>(data), bytes};
+    WriteAll(fd, &iov, 1);
+}
+
+inline void ReadAll(int fd, void* data, size_t bytes) {
+    auto* dest = static_cast<char*>(data);
+    while (bytes > 0) {
+        const ssize_t received = read(fd, dest, bytes);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ThrowSystemError("read");
+        }
+        if (received == 0) {
+            throw std::runtime_error("Unexpected end of serialized vector");
+        }
+        dest += received;
+        bytes -= static_cast<size_t>(received);
+    }
+}
+
+inline SerializedVectorHeader ReadHeader(int fd, size_t element_size) {
+    SerializedVectorHeader header{};
+    ReadAll(fd, &header, sizeof(header));
+    if (header.magic != SerializedVectorHeader::MAGIC || header.version != SerializedVectorHeader::VERSION) {
+        throw std::runtime_error("Not a serialized vector");
+    }
+    if (header.element_size != element_size) {
+        throw std::runtime_error("Serialized vector holds a different element type");
+    }
+    return header;
+}
+
+// Число элементов пришло из потока и не заслуживает доверия: бросает, если вместе с уже
+// прочитанными present элементами их байты не помещаются в size_t
+inline size_t CheckedCount(uint64_t count, size_t present, size_t element_size) {
+    const size_t limit = element_size != 0 ? SIZE_MAX / element_size : SIZE_MAX;
+    if (present > limit || count > limit - present) {
+        throw std::runtime_error("Serialized vector is too large");
+    }
+    return static_cast<size_t>(count);
+}
+
+// Копирует bytes байт из in_fd в out_fd: через sendfile, если ядро это умеет
+// для такой пары дескрипторов, иначе через промежуточный буфер
+inline void CopyBytes(int in_fd, int out_fd, size_t bytes) {
+#ifdef __linux__
+    while (bytes > 0) {
+        const ssize_t sent = sendfile(out_fd, in_fd, nullptr, bytes);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EINVAL || errno == ENOSYS) {
+                break;
+            }
+            ThrowSystemError("sendfile");
+        }
+        if (sent == 0) {
+            throw std::runtime_error("Unexpected end of serialized vector");
+        }
+        bytes -= static_cast<size_t>(sent);
+    }
+#endif
+    char buffer[1 << 16];
+    while (bytes > 0) {
+        const size_t chunk = std::min(bytes, sizeof(buffer));
+        ReadAll(in_fd, buffer, chunk);
+        WriteAll(out_fd, buffer, chunk);
+        bytes -= chunk;
+    }
+}
+
+}  // namespace vector_detail
+
+// Пишет заголовок и буфер вектора одним writev, без промежуточных копий
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim>
+void WriteTo(int fd, const Vector<T, Alloc, Growth, Stats, Reclaim>& vector) {
+    static_assert(std::is_trivially_copyable_v<T>, "WriteTo requires trivially copyable elements");
+    SerializedVectorHeader header{SerializedVectorHeader::MAGIC, SerializedVectorHeader::VERSION, 0, sizeof(T),
+                                  vector.Size()};
+    iovec iov[] = {{&header, sizeof(header)},
+                   {const_cast<T*>(vector.begin()), vector.Size() * sizeof(T)}};
+    vector_detail::WriteAll(fd, iov, 2);
+}
+
+// Читает вектор, записанный WriteTo или VectorStreamWriter, прямо в буфер vector.
+// Старое содержимое заменяется, при ошибке vector остаётся пустым
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim>
+void ReadFrom(int fd, Vector<T, Alloc, Growth, Stats, Reclaim>& vector) {
+    static_assert(std::is_trivially_copyable_v<T>, "ReadFrom requires trivially copyable elements");
+    vector.Clear();
+    try {
+        const SerializedVectorHeader header = vector_detail::ReadHeader(fd, sizeof(T));
+        if ((header.flags & SerializedVectorHeader::CHUNKED) == 0) {
+            const size_t size = vector_detail::CheckedCount(header.size, 0, sizeof(T));
+            vector.ResizeDefaultInit(size);
+            vector_detail::ReadAll(fd, vector.begin(), size * sizeof(T));
+            return;
+        }
+        uint64_t prefix = 0;
+        while (vector_detail::ReadAll(fd, &prefix, sizeof(prefix)), prefix != 0) {
+            const size_t size = vector.Size();
+            const size_t count = vector_detail::CheckedCount(prefix, size, sizeof(T));
+            if (size + count > vector.Capacity()) {
+                vector.Reserve(std::max<size_t>(vector.Capacity() * 2, size + count));
+            }
+            vector.ResizeDefaultInit(size + count);
+            vector_detail::ReadAll(fd, vector.begin() + size, count * sizeof(T));
+        }
+    } catch (...) {
+        vector.Clear();
+        throw;
+    }
+}
+
+// Пересылает вектор, записанный WriteTo, из in_fd в out_fd (например, из файла в сокет).
+// Данные не проходят через пространство пользователя, если ядро поддерживает sendfile
+inline void ForwardSerialized(int in_fd, int out_fd, size_t element_size) {
+    const SerializedVectorHeader header = vector_detail::ReadHeader(in_fd, element_size);
+    if ((header.flags & SerializedVectorHeader::CHUNKED) != 0) {
+        throw std::runtime_error("ForwardSerialized does not support chunked vectors");
+    }
+    const size_t size = vector_detail::CheckedCount(header.size, 0, element_size);
+    vector_detail::WriteAll(out_fd, &header, sizeof(header));
+    vector_detail::CopyBytes(in_fd, out_fd, size * element_size);
+}
+
+// Пишет вектор по частям, не зная заранее его размер:
+//   VectorStreamWriter<Record> writer(fd);
+//   while (...) writer.Write(batch);
+//   writer.Finish();
+// Без Finish() поток остаётся незавершённым, и ReadFrom бросит исключение
+template <typename T>
+class VectorStreamWriter {
+    static_assert(std::is_trivially_copyable_v<T>, "VectorStreamWriter requires trivially copyable elements");
+
+public:
+    explicit VectorStreamWriter(int fd)
+        : fd_(fd)
+    {
+        SerializedVectorHeader header{SerializedVectorHeader::MAGIC, SerializedVectorHeader::VERSION,
+                                      SerializedVectorHeader::CHUNKED, sizeof(T), 0};
+        vector_detail::WriteAll(fd_, &header, sizeof(header));
+    }
+
+    void Write(const T* data, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        uint64_t prefix = count;
+        iovec iov[] = {{&prefix, sizeof(prefix)}, {const_cast<T*>(data), count * sizeof(T)}};
+        vector_detail::WriteAll(fd_, iov, 2);
+    }
+
+    template <typename Alloc, typename Growth, typename Stats, typename Reclaim>
+    void Write(const Vector<T, Alloc, Growth, Stats, Reclaim>& chunk) {
+        Write(chunk.begin(), chunk.Size());
+    }
+
+    void Finish() {
+        const uint64_t end = 0;
+        vector_detail::WriteAll(fd_, &end, sizeof(end));
+    }
+
+private:
+    int fd_;
+};
+
+// Читает вектор частями не больше max_chunk элементов, переиспользуя буфер chunk.
+// Понимает оба формата: записанный WriteTo и VectorStreamWriter
+template <typename T>
+class VectorStreamReader {
+    static_assert(std::is_trivially_copyable_v<T>, "VectorStreamReader requires trivially copyable elements");
+
+public:
+    explicit VectorStreamReader(int fd, size_t max_chunk = size_t{1} << 16)
+        : fd_(fd)
+        , max_chunk_(max_chunk)
+    {
+        assert(max_chunk_ > 0);
+        const SerializedVectorHeader header = vector_detail::ReadHeader(fd_, sizeof(T));
+        chunked_ = (header.flags & SerializedVectorHeader::CHUNKED) != 0;
+        remaining_ = chunked_ ? 0 : header.size;
+        finished_ = !chunked_ && remaining_ == 0;
+    }
+
+    // Заменяет содержимое chunk следующей частью, возвращает false в конце потока
+    template <typename Alloc, typename Growth, typename Stats, typename Reclaim>
+    bool ReadChunk(Vector<T, Alloc, Growth, Stats, Reclaim>& chunk) {
+        chunk.Clear();
+        if (remaining_ == 0 && chunked_ && !finished_) {
+            vector_detail::ReadAll(fd_, &remaining_, sizeof(remaining_));
+            finished_ = remaining_ == 0;
+        }
+        if (finished_) {
+            return false;
+        }
+        const size_t count =
+            vector_detail::CheckedCount(std::min<uint64_t>(remaining_, max_chunk_), 0, sizeof(T));
+        chunk.ResizeDefaultInit(count);
+        vector_detail::ReadAll(fd_, chunk.begin(), count * sizeof(T));
+        remaining_ -= count;
+        finished_ = !chunked_ && remaining_ == 0;
+        return true;
+    }
+
+private:
+    int fd_;
+    size_t max_chunk_;
+    uint64_t remaining_ = 0;
+    bool chunked_ = false;
+    bool finished_ = false;
+};
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "vector.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+// Отложенное освобождение больших буферов Vector, чтобы уничтожение миллионов элементов
+// и освобождение блока не попадали на горячий путь. Политика подключается параметром Reclaim:
+//   Vector<std::string, std::allocator<std::string>, DoublingGrowth, NoStats, BackgroundReclaim<>>
+// Буферы меньше MinBytes освобождаются сразу. Если отложенных байт больше MaxPendingBytes,
+// буфер освобождается в вызывающем потоке: память не растёт без ограничений, а поставщик
+// буферов замедляется до скорости освобождения
+
+namespace vector_detail {
+
+// Буфер, ожидающий освобождения. Деструктор наследника уничтожает элементы и отдаёт память
+struct RetiredBuffer {
+    virtual ~RetiredBuffer() = default;
+
+    RetiredBuffer* next = nullptr;
+    size_t bytes = 0;
+};
+
+template <typename T, typename Alloc>
+struct RetiredVectorBuffer final : RetiredBuffer {
+    RetiredVectorBuffer(RawMemory<T, Alloc>&& buffer, size_t size) noexcept
+        : buffer(std::move(buffer))
+        , size(size)
+    {
+        bytes = this->buffer.Capacity() * sizeof(T);
+    }
+
+    ~RetiredVectorBuffer() override {
+        std::destroy_n(buffer.GetAddress(), size);
+    }
+
+    RawMemory<T, Alloc> buffer;
+    size_t size;
+};
+
+// Забирает буфер в узел очереди; nullptr, если узел выделить не удалось и буфер остался на месте
+template <typename T, typename Alloc>
+RetiredBuffer* MakeRetired(RawMemory<T, Alloc>& buffer, size_t size) noexcept {
+    return new (std::nothrow) RetiredVectorBuffer<T, Alloc>(std::move(buffer), size);
+}
+
+// Освобождает список и возвращает число освобождённых байт
+inline size_t ReleaseList(RetiredBuffer* head) noexcept {
+    size_t bytes = 0;
+    while (head != nullptr) {
+        RetiredBuffer* next = head->next;
+        bytes += head->bytes;
+        delete head;
+        head = next;
+    }
+    return bytes;
+}
+
+// Пакет отложенных буферов потока. Освобождение элементов может откладывать новые буферы
+// (вектор векторов), поэтому Release повторяется, пока пакет не опустеет
+struct DeferredBatch {
+    ~DeferredBatch();
+
+    void Push(RetiredBuffer* buffer) noexcept {
+        buffer->next = head;
+        head = buffer;
+        bytes += buffer->bytes;
+    }
+
+    void Release() noexcept {
+        while (head != nullptr) {
+            RetiredBuffer* list = std::exchange(head, nullptr);
+            bytes = 0;
+            ReleaseList(list);
+        }
+    }
+
+    RetiredBuffer* head = nullptr;
+    size_t bytes = 0;
+};
+
+// Тривиальный флаг доступен и после уничтожения пакета при завершении потока
+inline thread_local bool deferred_batch_destroyed = false;
+
+inline DeferredBatch::~DeferredBatch() {
+    Release();
+    deferred_batch_destroyed = true;
+}
+
+inline DeferredBatch* ThreadBatch() noexcept {
+    if (deferred_batch_destroyed) {
+        return nullptr;
+    }
+    thread_local DeferredBatch batch;
+    return &batch;
+}
+
+}  // namespace vector_detail
+
+// Фоновый поток, освобождающий отложенные буферы. Создаётся при первом обращении и живёт
+// до завершения процесса: векторы в статических объектах могут уничтожаться позже любого
+// другого статического объекта. Буферы, не освобождённые к выходу, возвращает система
+class BackgroundReclaimer {
+public:
+    // nullptr, если поток запустить не удалось
+    static BackgroundReclaimer* Instance() noexcept {
+        static BackgroundReclaimer* instance = Create();
+        return instance;
+    }
+
+    BackgroundReclaimer(const BackgroundReclaimer&) = delete;
+    BackgroundReclaimer& operator=(const BackgroundReclaimer&) = delete;
+
+    // Ставит буфер в очередь. false, если очередь превысила бы max_pending_bytes:
+    // тогда буфер освобождает вызывающий
+    bool TryEnqueue(vector_detail::RetiredBuffer* buffer, size_t max_pending_bytes) noexcept {
+        {
+            std::lock_guard lock(mutex_);
+            if (pending_bytes_ + buffer->bytes > max_pending_bytes) {
+                return false;
+            }
+            pending_bytes_ += buffer->bytes;
+            buffer->next = head_;
+            head_ = buffer;
+        }
+        wake_.notify_one();
+        return true;
+    }
+
+    // Ждёт, пока освободятся все поставленные в очередь буферы
+    void Drain() {
+        std::unique_lock lock(mutex_);
+        drained_.wait(lock, [this] {
+            return head_ == nullptr && !busy_;
+        });
+    }
+
+    // Память в очереди и в освобождении, учтённая по ёмкости буферов
+    [[nodiscard]] size_t PendingBytes() const {
+        std::lock_guard lock(mutex_);
+        return pending_bytes_;
+    }
+
+private:
+    BackgroundReclaimer() = default;
+
+    static BackgroundReclaimer* Create() noexcept {
+        auto* reclaimer = new (std::nothrow) BackgroundReclaimer();
+        if (reclaimer == nullptr) {
+            return nullptr;
+        }
+        try {
+            std::thread(&BackgroundReclaimer::Run, reclaimer).detach();
+        } catch (...) {
+            delete reclaimer;
+            return nullptr;
+        }
+        return reclaimer;
+    }
+
+    void Run() noexcept {
+        std::unique_lock lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [this] {
+                return head_ != nullptr;
+            });
+            vector_detail::RetiredBuffer* list = std::exchange(head_, nullptr);
+            busy_ = true;
+            lock.unlock();
+            const size_t released = vector_detail::ReleaseList(list);
+            lock.lock();
+            pending_bytes_ -= released;
+            busy_ = head_ != nullptr;
+            if (!busy_) {
+                drained_.notify_all();
+            }
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable drained_;
+    vector_detail::RetiredBuffer* head_ = nullptr;
+    size_t pending_bytes_ = 0;
+    bool busy_ = false;
+};
+
+// Уничтожение элементов и освобождение памяти в фоновом потоке. Элементы уничтожаются
+// в другом потоке, а аллокатор должен позволять освобождение из любого потока,
+// поэтому допускаются только аллокаторы без состояния
+template <size_t MinBytes = size_t{1} << 20, size_t MaxPendingBytes = size_t{1} << 30>
+struct BackgroundReclaim {
+    template <typename T, typename Alloc>
+    static void Retire(RawMemory<T, Alloc> buffer, size_t size) noexcept {
+        static_assert(std::allocator_traits<Alloc>::is_always_equal::value,
+                      "BackgroundReclaim requires a stateless allocator");
+        if (buffer.Capacity() * sizeof(T) >= MinBytes && buffer.Capacity() != 0) {
+            if (BackgroundReclaimer* reclaimer = BackgroundReclaimer::Instance()) {
+                if (vector_detail::RetiredBuffer* retired = vector_detail::MakeRetired(buffer, size)) {
+                    if (!reclaimer->TryEnqueue(retired, MaxPendingBytes)) {
+                        delete retired;
+                    }
+                    return;
+                }
+            }
+        }
+        ImmediateReclaim::Retire(std::move(buffer), size);
+    }
+};
+
+// Буферы копятся в пакете текущего потока и освобождаются в ReclaimDeferred(), которую
+// вызывают в точке покоя (между запросами). Пакет больше MaxPendingBytes освобождается сразу,
+// остаток — при завершении потока
+template <size_t MinBytes = size_t{1} << 20, size_t MaxPendingBytes = size_t{1} << 28>
+struct DeferredReclaim {
+    template <typename T, typename Alloc>
+    static void Retire(RawMemory<T, Alloc> buffer, size_t size) noexcept {
+        if (buffer.Capacity() * sizeof(T) >= MinBytes && buffer.Capacity() != 0) {
+            if (vector_detail::DeferredBatch* batch = vector_detail::ThreadBatch()) {
+                if (vector_detail::RetiredBuffer* retired = vector_detail::MakeRetired(buffer, size)) {
+                    batch->Push(retired);
+                    if (batch->bytes > MaxPendingBytes) {
+                        batch->Release();
+                    }
+                    return;
+                }
+            }
+        }
+        ImmediateReclaim::Retire(std::move(buffer), size);
+    }
+};
+
+// Освобождает буферы, отложенные DeferredReclaim в текущем потоке
+inline void ReclaimDeferred() noexcept {
+    if (vector_detail::DeferredBatch* batch = vector_detail::ThreadBatch()) {
+        batch->Release();
+    }
+}
+
+// Память, отложенная DeferredReclaim в текущем потоке
+[[nodiscard]] inline size_t DeferredPendingBytes() noexcept {
+    const vector_detail::DeferredBatch* batch = vector_detail::ThreadBatch();
+    return batch != nullptr ? batch->bytes : 0;
+}
@@ -0,0 +1,416 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+// Векторизованные ядра Fill, Sum, MinMax, Find, Count и Transform для Vector арифметических типов.
+// Ядра написаны один раз на векторных расширениях GCC/Clang и собираются под 16 байт
+// (SSE2, NEON), 32 байта (AVX2) и 64 байта (AVX-512), а ширина выбирается при первом вызове
+// по возможностям процессора. Загрузки невыровненные, но с буфером AlignedVector
+// (aligned_allocator.h) не пересекают кэш-линии. Без векторных расширений выполняются
+// скалярные алгоритмы std
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VECTOR_SIMD_EXTENSIONS 1
+#if defined(__x86_64__) || defined(__i386__)
+#define VECTOR_SIMD_X86 1
+#endif
+#endif
+
+enum class SimdLevel {
+    SCALAR,
+    SSE2,
+    NEON,
+    AVX2,
+    AVX512,
+};
+
+namespace simd_detail {
+
+inline SimdLevel DetectSimdLevel() noexcept {
+#if defined(VECTOR_SIMD_X86)
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+#if defined(__SSE2__)
+    return SimdLevel::SSE2;
+#endif
+#elif defined(VECTOR_SIMD_EXTENSIONS) && (defined(__ARM_NEON) || defined(__aarch64__))
+    return SimdLevel::NEON;
+#endif
+    return SimdLevel::SCALAR;
+}
+
+inline std::atomic<SimdLevel>& ActiveLevel() noexcept {
+    static std::atomic<SimdLevel> level = DetectSimdLevel();
+    return level;
+}
+
+template <typename T>
+struct Identity {
+    using type = T;
+};
+
+// Скалярные реализации: запасной путь и эталон для проверки
+template <typename T>
+struct Scalar {
+    static void Fill(T* data, size_t size, T value) {
+        std::fill_n(data, size, value);
+    }
+
+    static T Sum(const T* data, size_t size) {
+        return std::accumulate(data, data + size, T{});
+    }
+
+    static std::pair<T, T> MinMax(const T* data, size_t size) {
+        const auto [min, max] = std::minmax_element(data, data + size);
+        return {*min, *max};
+    }
+
+    static size_t Find(const T* data, size_t size, T value) {
+        return std::find(data, data + size, value) - data;
+    }
+
+    static size_t Count(const T* data, size_t size, T value) {
+        return std::count(data, data + size, value);
+    }
+
+    template <typename Op>
+    static void Transform(const T* lhs, const T* rhs, T* out, size_t size, Op op) {
+        std::transform(lhs, lhs + size, rhs, out, op);
+    }
+};
+
+template <typename Op, typename T>
+inline constexpr bool is_simd_op_v =
+    std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::plus<T>> || std::is_same_v<Op, std::minus<>>
+    || std::is_same_v<Op, std::minus<T>> || std::is_same_v<Op, std::multiplies<>>
+    || std::is_same_v<Op, std::multiplies<T>> || std::is_same_v<Op, std::divides<>>
+    || std::is_same_v<Op, std::divides<T>>;
+
+// Ядра как параметры обёрток: Run<Impl> вызывает одноимённую функцию реализации Impl
+struct FillKernel {
+    template <typename Impl, typename... Args>
+    [[gnu::always_inline]] static auto Run(Args... args) {
+        return Impl::Fill(args...);
+    }
+};
+
+struct SumKernel {
+    template <typename Impl, typename... Args>
+    [[gnu::always_inline]] static auto Run(Args... args) {
+        return Impl::Sum(args...);
+    }
+};
+
+struct MinMaxKernel {
+    template <typename Impl, typename... Args>
+    [[gnu::always_inline]] static auto Run(Args... args) {
+        return Impl::MinMax(args...);
+    }
+};
+
+struct FindKernel {
+    template <typename Impl, typename... Args>
+    [[gnu::always_inline]] static auto Run(Args... args) {
+        return Impl::Find(args...);
+    }
+};
+
+struct CountKernel {
+    template <typename Impl, typename... Args>
+    [[gnu::always_inline]] static auto Run(Args... args) {
+        return Impl::Count(args...);
+    }
+};
+
+struct TransformKernel {
+    template <typename Impl, typename... Args>
+    [[gnu::always_inline]] static auto Run(Args... args) {
+        return Impl::Transform(args...);
+    }
+};
+
+#if defined(VECTOR_SIMD_EXTENSIONS)
+
+template <size_t Size>
+struct SignedOfSize;
+template <>
+struct SignedOfSize<1> {
+    using type = int8_t;
+};
+template <>
+struct SignedOfSize<2> {
+    using type = int16_t;
+};
+template <>
+struct SignedOfSize<4> {
+    using type = int32_t;
+};
+template <>
+struct SignedOfSize<8> {
+    using type = int64_t;
+};
+
+// Ядра шириной Width байт. Векторные значения не пересекают границ функций:
+// ядра встраиваются в обёртки с атрибутом target и принимают только указатели и скаляры
+template <typename T, size_t Width>
+struct Simd {
+    static constexpr size_t LANES = Width / sizeof(T);
+    using Lane = typename SignedOfSize<sizeof(T)>::type;
+    // Целые складываются и умножаются в беззнаковых дорожках, где переполнение определено
+    using Wrapping = typename std::conditional_t<std::is_integral_v<T>, std::make_unsigned<T>, Identity<T>>::type;
+    typedef T Vec __attribute__((vector_size(Width)));
+    typedef Lane Mask __attribute__((vector_size(Width)));
+    typedef Wrapping WrappingVec __attribute__((vector_size(Width)));
+
+    [[gnu::always_inline]] static void Fill(T* data, size_t size, T value) {
+        const Vec fill = Vec{} + value;
+        size_t i = 0;
+        for (; i + LANES <= size; i += LANES) {
+            __builtin_memcpy(data + i, &fill, Width);
+        }
+        std::fill(data + i, data + size, value);
+    }
+
+    [[gnu::always_inline]] static T Sum(const T* data, size_t size) {
+        // Два аккумулятора прячут задержку сложения
+        WrappingVec acc0{};
+        WrappingVec acc1{};
+        size_t i = 0;
+        for (; i + 2 * LANES <= size; i += 2 * LANES) {
+            WrappingVec x0;
+            WrappingVec x1;
+            __builtin_memcpy(&x0, data + i, Width);
+            __builtin_memcpy(&x1, data + i + LANES, Width);
+            acc0 += x0;
+            acc1 += x1;
+        }
+        for (; i + LANES <= size; i += LANES) {
+            WrappingVec x;
+            __builtin_memcpy(&x, data + i, Width);
+            acc0 += x;
+        }
+        acc0 += acc1;
+        Wrapping sum{};
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            sum += acc0[lane];
+        }
+        for (; i < size; ++i) {
+            sum += static_cast<Wrapping>(data[i]);
+        }
+        return static_cast<T>(sum);
+    }
+
+    [[gnu::always_inline]] static std::pair<T, T> MinMax(const T* data, size_t size) {
+        Vec min = Vec{} + data[0];
+        Vec max = min;
+        size_t i = 0;
+        for (; i + LANES <= size; i += LANES) {
+            Vec x;
+            __builtin_memcpy(&x, data + i, Width);
+            const Mask less = x < min;
+            const Mask greater = x > max;
+            min = reinterpret_cast<Vec>((reinterpret_cast<Mask>(x) & less) | (reinterpret_cast<Mask>(min) & ~less));
+            max = reinterpret_cast<Vec>((reinterpret_cast<Mask>(x) & greater)
+                                        | (reinterpret_cast<Mask>(max) & ~greater));
+        }
+        std::pair<T, T> result{min[0], max[0]};
+        for (size_t lane = 1; lane < LANES; ++lane) {
+            result.first = std::min<T>(result.first, min[lane]);
+            result.second = std::max<T>(result.second, max[lane]);
+        }
+        for (; i < size; ++i) {
+            result.first = std::min(result.first, data[i]);
+            result.second = std::max(result.second, data[i]);
+        }
+        return result;
+    }
+
+    [[gnu::always_inline]] static size_t Find(const T* data, size_t size, T value) {
+        const Vec needle = Vec{} + value;
+        size_t i = 0;
+        for (; i + LANES <= size; i += LANES) {
+            Vec x;
+            __builtin_memcpy(&x, data + i, Width);
+            const Mask equal = x == needle;
+            uint64_t words[Width / sizeof(uint64_t)];
+            __builtin_memcpy(words, &equal, Width);
+            uint64_t any = 0;
+            for (uint64_t word : words) {
+                any |= word;
+            }
+            if (any != 0) {
+                size_t lane = 0;
+                while (equal[lane] == 0) {
+                    ++lane;
+                }
+                return i + lane;
+            }
+        }
+        return std::find(data + i, data + size, value) - data;
+    }
+
+    [[gnu::always_inline]] static size_t Count(const T* data, size_t size, T value) {
+        // Счётчики в дорожках ширины T сбрасываются в size_t до переполнения
+        constexpr size_t FLUSH_BLOCKS = std::min<size_t>(std::numeric_limits<Lane>::max(), size_t{1} << 30);
+        const Vec needle = Vec{} + value;
+        size_t count = 0;
+        size_t i = 0;
+        while (i + LANES <= size) {
+            Mask acc{};
+            for (size_t block = 0; block < FLUSH_BLOCKS && i + LANES <= size; ++block, i += LANES) {
+                Vec x;
+                __builtin_memcpy(&x, data + i, Width);
+                acc -= x == needle;
+            }
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                count += static_cast<size_t>(acc[lane]);
+            }
+        }
+        return count + std::count(data + i, data + size, value);
+    }
+
+    template <typename Op>
+    [[gnu::always_inline]] static void Transform(const T* lhs, const T* rhs, T* out, size_t size, Op op) {
+        constexpr bool DIVIDES = std::is_same_v<Op, std::divides<>> || std::is_same_v<Op, std::divides<T>>;
+        using OperandLane = std::conditional_t<DIVIDES, T, Wrapping>;
+        typedef OperandLane Operand __attribute__((vector_size(Width)));
+        size_t i = 0;
+        for (; i + LANES <= size; i += LANES) {
+            Operand x;
+            Operand y;
+            __builtin_memcpy(&x, lhs + i, Width);
+            __builtin_memcpy(&y, rhs + i, Width);
+            if constexpr (std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::plus<T>>) {
+                x += y;
+            } else if constexpr (std::is_same_v<Op, std::minus<>> || std::is_same_v<Op, std::minus<T>>) {
+                x -= y;
+            } else if constexpr (std::is_same_v<Op, std::multiplies<>> || std::is_same_v<Op, std::multiplies<T>>) {
+                x *= y;
+            } else {
+                static_assert(DIVIDES);
+                x /= y;
+            }
+            __builtin_memcpy(out + i, &x, Width);
+        }
+        std::transform(lhs + i, lhs + size, rhs + i, out + i, op);
+    }
+};
+
+
+#if defined(VECTOR_SIMD_X86)
+
+template <typename T, typename Kernel, typename... Args>
+__attribute__((target("avx2"))) auto RunAvx2(Args... args) {
+    return Kernel::template Run<Simd<T, 32>>(args...);
+}
+
+template <typename T, typename Kernel, typename... Args>
+__attribute__((target("avx512f"))) auto RunAvx512(Args... args) {
+    return Kernel::template Run<Simd<T, 64>>(args...);
+}
+
+#endif
+#endif  // VECTOR_SIMD_EXTENSIONS
+
+template <typename T, typename Kernel, typename... Args>
+auto Dispatch([[maybe_unused]] SimdLevel level, Args... args) {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "SIMD kernels require an arithmetic type");
+#if defined(VECTOR_SIMD_X86)
+    // В AVX-512F нет сравнений 8- и 16-битных целых, для них достаточно AVX2
+    if constexpr (sizeof(T) >= 4) {
+        if (level == SimdLevel::AVX512) {
+            return RunAvx512<T, Kernel>(args...);
+        }
+    }
+    if (level >= SimdLevel::AVX2) {
+        return RunAvx2<T, Kernel>(args...);
+    }
+#endif
+#if defined(VECTOR_SIMD_EXTENSIONS)
+    if (level != SimdLevel::SCALAR) {
+        return Kernel::template Run<Simd<T, 16>>(args...);
+    }
+#endif
+    return Kernel::template Run<Scalar<T>>(args...);
+}
+
+template <typename T, typename Kernel, typename... Args>
+auto Dispatch(Args... args) {
+    return Dispatch<T, Kernel>(ActiveLevel().load(std::memory_order_relaxed), args...);
+}
+
+}  // namespace simd_detail
+
+// Набор инструкций, которым сейчас пользуются ядра
+inline SimdLevel GetSimdLevel() noexcept {
+    return simd_detail::ActiveLevel().load(std::memory_order_relaxed);
+}
+
+// Ограничивает ядра набором инструкций не выше level (для сравнений и тестов).
+// Возвращает установленный уровень: не выше того, что поддерживает процессор
+inline SimdLevel SetSimdLevel(SimdLevel level) noexcept {
+    const SimdLevel supported = simd_detail::DetectSimdLevel();
+    if (level > supported || (level != SimdLevel::SCALAR && supported == SimdLevel::NEON)) {
+        level = supported;
+    }
+    simd_detail::ActiveLevel().store(level, std::memory_order_relaxed);
+    return level;
+}
+
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim>
+void Fill(Vector<T, Alloc, Growth, Stats, Reclaim>& vector, typename simd_detail::Identity<T>::type value) {
+    simd_detail::Dispatch<T, simd_detail::FillKernel>(vector.begin(), vector.Size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim>
+T Sum(const Vector<T, Alloc, Growth, Stats, Reclaim>& vector) {
+    return simd_detail::Dispatch<T, simd_detail::SumKernel>(vector.begin(), vector.Size());
+}
+
+// Вектор не должен быть пустым. Для чисел с плавающей точкой NaN не поддерживается
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim>
+std::pair<T, T> MinMax(const Vector<T, Alloc, Growth, Stats, Reclaim>& vector) {
+    assert(vector.Size() > 0);
+    return simd_detail::Dispatch<T, simd_detail::MinMaxKernel>(vector.begin(), vector.Size());
+}
+
+// Возвращает итератор на первый элемент, равный value, или end()
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim>
+typename Vector<T, Alloc, Growth, Stats, Reclaim>::const_iterator Find(
+    const Vector<T, Alloc, Growth, Stats, Reclaim>& vector, typename simd_detail::Identity<T>::type value) {
+    return vector.begin() + simd_detail::Dispatch<T, simd_detail::FindKernel>(vector.begin(), vector.Size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim>
+size_t Count(const Vector<T, Alloc, Growth, Stats, Reclaim>& vector, typename simd_detail::Identity<T>::type value) {
+    return simd_detail::Dispatch<T, simd_detail::CountKernel>(vector.begin(), vector.Size(), value);
+}
+
+// out[i] = op(lhs[i], rhs[i]), out получает размер lhs и может совпадать с lhs или rhs.
+// Векторизуются std::plus, std::minus, std::multiplies и std::divides, прочие op — скалярно
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Reclaim, typename Op>
+void Transform(const Vector<T, Alloc, Growth, Stats, Reclaim>& lhs, const Vector<T, Alloc, Growth, Stats, Reclaim>& rhs,
+               Vector<T, Alloc, Growth, Stats, Reclaim>& out, Op op) {
+    assert(lhs.Size() == rhs.Size());
+    out.ResizeDefaultInit(lhs.Size());
+    if constexpr (simd_detail::is_simd_op_v<Op, T>) {
+        simd_detail::Dispatch<T, simd_detail::TransformKernel>(lhs.begin(), rhs.begin(), out.begin(), lhs.Size(), op);
+    } else {
+        std::transform(lhs.begin(), lhs.end(), rhs.begin(), out.begin(), op);
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "vector.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+
+// Счётчики одного места использования Vector
+struct VectorStats {
+    explicit VectorStats(std::string_view stats_name) noexcept
+        : name(stats_name)
+    {}
+
+    std::string_view name;
+    std::atomic<size_t> allocations = 0;
+    std::atomic<size_t> reallocations = 0;
+    std::atomic<size_t> bytes_allocated = 0;
+    std::atomic<size_t> elements_moved = 0;
+    std::atomic<size_t> elements_copied = 0;
+    std::atomic<size_t> elements_relocated = 0;
+    std::atomic<size_t> peak_capacity = 0;
+};
+
+// Глобальный реестр счётчиков, который можно выгрузить целиком или обойти
+class VectorStatsRegistry {
+public:
+    static VectorStatsRegistry& Instance() {
+        static VectorStatsRegistry registry;
+        return registry;
+    }
+
+    VectorStats& Register(std::string_view name) {
+        std::lock_guard guard(mutex_);
+        entries_.EmplaceBack(std::make_unique<VectorStats>(name));
+        return *entries_[entries_.Size() - 1];
+    }
+
+    template <typename Visitor>
+    void ForEach(Visitor visitor) const {
+        std::lock_guard guard(mutex_);
+        for (const auto& entry : entries_) {
+            visitor(static_cast<const VectorStats&>(*entry));
+        }
+    }
+
+    void Dump(std::ostream& out) const {
+        using namespace std::literals;
+        ForEach([&out](const VectorStats& stats) {
+            out << stats.name << ": allocations: "sv << stats.allocations                 //
+                << ", reallocations: "sv << stats.reallocations                          //
+                << ", bytes allocated: "sv << stats.bytes_allocated                      //
+                << ", moved: "sv << stats.elements_moved                                 //
+                << ", copied: "sv << stats.elements_copied                               //
+                << ", relocated: "sv << stats.elements_relocated                         //
+                << ", peak capacity: "sv << stats.peak_capacity << '\n';
+        });
+    }
+
+private:
+    VectorStatsRegistry() = default;
+
+    mutable std::mutex mutex_;
+    Vector<std::unique_ptr<VectorStats>> entries_;
+};
+
+#ifndef VECTOR_DISABLE_STATS
+
+// Политика, собирающая статистику в реестр под именем Tag::NAME:
+//   struct IngestTag { static constexpr std::string_view NAME = "ingest"; };
+//   using IngestVector = Vector<Record, std::allocator<Record>, DoublingGrowth, TaggedStats<IngestTag>>;
+// С макросом VECTOR_DISABLE_STATS превращается в NoStats
+template <typename Tag>
+struct TaggedStats {
+    static VectorStats& Get() {
+        static VectorStats& stats = VectorStatsRegistry::Instance().Register(Tag::NAME);
+        return stats;
+    }
+
+    static void OnAllocation(size_t bytes) {
+        Get().allocations.fetch_add(1, std::memory_order_relaxed);
+        Get().bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static void OnReallocation() {
+        Get().reallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void OnMoved(size_t count) {
+        Get().elements_moved.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    static void OnCopied(size_t count) {
+        Get().elements_copied.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    static void OnRelocated(size_t count) {
+        Get().elements_relocated.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    static void OnCapacity(size_t capacity) {
+        std::atomic<size_t>& peak = Get().peak_capacity;
+        size_t current = peak.load(std::memory_order_relaxed);
+        while (current < capacity && !peak.compare_exchange_weak(current, capacity, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+#else
+
+template <typename Tag>
+using TaggedStats = NoStats;
+
+#endif